@@ -48,6 +48,18 @@ class CeedlingAppConfig
       # If logging enabled, the filepath for Ceedling's log (may be explicitly set to be outside :logging_path)
       :log_filepath => '',
 
+      # Log file format: :text or :json (JSON lines)
+      :log_format => :text,
+
+      # Compact console progress display for parallel build steps
+      :progress => false,
+
+      # Stage / item / tool timing report (`--profile`)
+      :profile => false,
+
+      # Test build rebuild reasons & critical path report (`--explain`)
+      :explain => false,
+
       # Only specified in project config (no command line or environment variable)
       :default_tasks => ['test:all'],
 
@@ -71,7 +83,9 @@ class CeedlingAppConfig
     begin
       @app_cfg[:terminal_width] = (IO.console.winsize)[1]
     rescue
-      # Do nothing; allow value already set to stand as default
+      # No console (e.g. build forwarded to `ceedling server`); use any width a shell or client provided
+      columns = ENV['COLUMNS'].to_i
+      @app_cfg[:terminal_width] = columns if columns > 0
     end
   end 
 
@@ -87,6 +101,22 @@ class CeedlingAppConfig
     @app_cfg[:log_filepath] = filepath
   end
 
+  def set_log_format(format)
+    @app_cfg[:log_format] = format
+  end
+
+  def set_progress(enable)
+    @app_cfg[:progress] = enable
+  end
+
+  def set_profile(enable)
+    @app_cfg[:profile] = enable
+  end
+
+  def set_explain(enable)
+    @app_cfg[:explain] = enable
+  end
+
   def set_include_test_case(matcher)
     @app_cfg[:include_test_case] = matcher
   end
@@ -0,0 +1,166 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+# NOTE: This file is loaded before anything else in bin/ceedling.
+#       It must remain free of dependencies beyond Ruby's standard library.
+
+require 'socket'
+require 'json'
+
+##
+## Thin client for a running Ceedling build server (see `ceedling server`).
+##
+## The client forwards its command line, working directory, and environment
+## to the server over a Unix domain socket. The server runs the build in a
+## process forked from its preloaded state and streams back console output
+## followed by the build's exit code.
+##
+## Wire format (both directions after the initial JSON request line):
+##   <1 byte frame type><4 byte big-endian payload length><payload>
+##
+module BuildClient
+
+  SOCKET_ENV_VAR  = 'CEEDLING_SERVER_SOCKET'
+  DISABLE_ENV_VAR = 'CEEDLING_NO_SERVER'
+  DEFAULT_SOCKET  = '.ceedling-server.sock'
+
+  FRAME_STDOUT = 'o'
+  FRAME_STDERR = 'e'
+  FRAME_EXIT   = 'x'
+  FRAME_RELOAD = 'r'
+
+  # How long a client waits on a server that is reloading before building locally
+  RELOAD_RETRIES   = 40
+  RELOAD_BACKOFF_S = 0.25
+
+  # Socket filepath from environment or default filename in working directory
+  def self.socket_path(env)
+    return env[SOCKET_ENV_VAR] || DEFAULT_SOCKET
+  end
+
+
+  def self.available?()
+    return defined?( UNIXSocket ) ? true : false
+  end
+
+
+  def self.write_frame(io, type, payload)
+    _payload = payload.b()
+    io.write( [type, _payload.bytesize].pack( 'a1N' ) + _payload )
+  end
+
+
+  # Returns [type, payload] or nil if the connection closed
+  def self.read_frame(io)
+    header = io.read( 5 )
+    return nil if header.nil? or header.bytesize < 5
+
+    type, length = header.unpack( 'a1N' )
+    payload = (length > 0) ? io.read( length ) : ''
+    return nil if payload.nil?
+
+    return type, payload
+  end
+
+
+  # Send a single request and yield each response frame.
+  # Returns the exit code from the server, :reload if the server asked us to retry, or nil on a dropped connection.
+  def self.request(socket, request)
+    UNIXSocket.open( socket ) do |conn|
+      conn.binmode
+      conn.puts( JSON.generate( request ) )
+
+      while (frame = read_frame( conn ))
+        type, payload = frame
+        case type
+        when FRAME_EXIT   then return payload.to_i
+        when FRAME_RELOAD then return :reload
+        else
+          yield( type, payload ) if block_given?
+        end
+      end
+    end
+
+    return nil
+  end
+
+
+  # Server is listening if we can complete a status request
+  def self.alive?(socket)
+    return false if !available?
+    return false if !File.exist?( socket )
+
+    begin
+      return !request( socket, {'command' => 'status'} ).nil?
+    rescue SystemCallError, IOError
+      return false
+    end
+  end
+
+
+  # Forward a command line to a build server if one is listening.
+  # Returns the exit code of the build or nil if the command line should be processed locally.
+  def self.forward(argv, env)
+    # `ceedling server ...` commands are always handled locally
+    return nil if argv.first == 'server'
+    return nil if !env[DISABLE_ENV_VAR].nil?
+    return nil if !available?
+
+    socket = socket_path( env )
+    return nil if !File.exist?( socket )
+
+    _env = env.to_h()
+    # A daemonized server has no terminal; tell it ours
+    columns = terminal_columns()
+    _env['COLUMNS'] = columns.to_s() if !columns.nil?
+
+    request = {
+      'command' => 'build',
+      'argv'    => argv,
+      'cwd'     => Dir.pwd(),
+      'env'     => _env
+    }
+
+    RELOAD_RETRIES.times do
+      begin
+        result = request( socket, request ) do |type, payload|
+          stream = (type == FRAME_STDERR) ? $stderr : $stdout
+          stream.write( payload )
+          stream.flush
+        end
+      # Server went away or socket is stale -- build locally
+      rescue SystemCallError, IOError
+        return nil
+      end
+
+      # Server is restarting after detecting changes -- wait on it
+      if result == :reload
+        sleep( RELOAD_BACKOFF_S )
+        next
+      end
+
+      # Connection dropped without an exit code
+      return 1 if result.nil?
+
+      return result
+    end
+
+    # Server never came back; build locally
+    return nil
+  end
+
+
+  def self.terminal_columns()
+    begin
+      require 'io/console'
+      return IO.console.winsize[1]
+    rescue StandardError
+      return nil
+    end
+  end
+
+end
@@ -0,0 +1,389 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'socket'
+require 'json'
+require 'rbconfig'
+require 'build_client' # Wire protocol shared with thin client
+require 'ceedling/constants' # From Ceedling application
+require 'ceedling/exceptions'
+
+##
+## Opt-in background build server.
+##
+## The server preloads Ruby, Thor, Rake, the Ceedling application, and the
+## Ruby code of a project's enabled plugins once. Each forwarded command line
+## runs in a process forked from that warm state so every build starts from
+## a clean slate (fresh configuration, objects, and Rake tasks) without paying
+## startup costs.
+##
+## The server watches the project file and all Ceedling Ruby code it has
+## loaded. Upon any change it restarts itself. Clients waiting on a restart
+## retry automatically.
+##
+class BuildServer
+
+  # Interval at which an idle server checks watched files for changes
+  WATCH_INTERVAL_S = 1.0
+
+  # How long `start` waits for a daemonized server to begin listening
+  STARTUP_TIMEOUT_S = 30
+
+  # Globals the launcher defines that must not leak from the server into a build
+  LAUNCHER_CONSTANTS = [:CEEDLING_APPCFG, :CEEDLING_HANDOFF_OBJECTS, :PROJECT_VERBOSITY, :PROJECT_DEBUG]
+
+  # Ruby libraries used by every build
+  PRELOAD_LIBRARIES = ['rake', 'diy', 'constructor', 'deep_merge', 'parallel', 'yaml', 'erb', 'fileutils', 'benchmark']
+
+  constructor :file_wrapper, :yaml_wrapper, :system_wrapper, :loginator
+
+  # Override to prevent exception handling from walking & stringifying the object variables.
+  def inspect
+    return this.class.name
+  end
+
+
+  def setup()
+    @listener = nil
+    @stopping = false
+    @reloading = false
+    @builds = 0
+    @started = nil
+    @handlers = []
+    @lock = Mutex.new
+    @fork_lock = Mutex.new
+  end
+
+
+  def start(app_cfg:, socket:, foreground:false)
+    if @system_wrapper.windows?
+      raise CeedlingException.new( "The Ceedling build server requires Unix domain sockets and is not available on Windows" )
+    end
+
+    if BuildClient.alive?( socket )
+      raise CeedlingException.new( "A Ceedling build server is already listening at #{socket}" )
+    end
+
+    # Remove any stale socket left behind by a server that did not shut down cleanly
+    @file_wrapper.rm_f( socket )
+
+    if foreground
+      @loginator.log( "Ceedling build server listening at #{socket} (Ctrl-C to stop)", Verbosity::NORMAL, LogLabels::TITLE )
+      # Wait for console output to drain before the server takes over the process
+      @loginator.wrapup()
+      serve( app_cfg, socket )
+      return
+    end
+
+    logfile = socket + '.log'
+
+    # Classic double fork so the daemon is detached from our terminal and session
+    pid = fork do
+      Process.setsid()
+      exit!( 0 ) if fork
+
+      $stdin.reopen( File::NULL )
+      $stdout.reopen( logfile, 'a' )
+      $stderr.reopen( $stdout )
+      $stdout.sync = true
+
+      begin
+        serve( app_cfg, socket )
+      rescue StandardError => ex
+        $stderr.puts( "#{Time.now} | Build server failed: #{ex.message}" )
+        $stderr.puts( ex.backtrace )
+      end
+      exit!( 0 )
+    end
+    Process.wait( pid )
+
+    # Preloading can take a moment
+    deadline = Time.now + STARTUP_TIMEOUT_S
+    while !BuildClient.alive?( socket )
+      if Time.now > deadline
+        raise CeedlingException.new( "Ceedling build server did not start listening at #{socket} (see #{logfile})" )
+      end
+      sleep( 0.1 )
+    end
+
+    @loginator.log( "Ceedling build server listening at #{socket}\n > Server log: #{logfile}", Verbosity::NORMAL, LogLabels::TITLE )
+  end
+
+
+  def stop(socket:)
+    if !BuildClient.alive?( socket )
+      @loginator.log( "No Ceedling build server is listening at #{socket}", Verbosity::COMPLAIN )
+      return
+    end
+
+    BuildClient.request( socket, {'command' => 'stop'} )
+    @loginator.log( "Stopped Ceedling build server at #{socket}", Verbosity::NORMAL, LogLabels::TITLE )
+  end
+
+
+  def status(socket:)
+    if !BuildClient.alive?( socket )
+      @loginator.log( "No Ceedling build server is listening at #{socket}", Verbosity::NORMAL )
+      return
+    end
+
+    report = ''
+    BuildClient.request( socket, {'command' => 'status'} ) {|_, payload| report << payload }
+    @loginator.log( report, Verbosity::NORMAL, LogLabels::TITLE )
+  end
+
+
+  ### Private ###
+
+  private
+
+  def serve(app_cfg, socket)
+    @script = File.join( app_cfg[:ceedling_root_path], 'bin', 'ceedling' )
+    @project_filepath = File.expand_path( ENV[Projectinator::PROJECT_FILEPATH_ENV_VAR] || DEFAULT_PROJECT_FILENAME )
+
+    preload( app_cfg )
+    @fingerprint = fingerprint( app_cfg )
+
+    @listener = UNIXServer.new( socket )
+    @started = Time.now
+
+    begin
+      while !@stopping
+        # Restart once any build in progress finishes relaying its output
+        if stale?( app_cfg )
+          @reloading = true
+          break
+        end
+
+        ready = IO.select( [@listener], nil, nil, WATCH_INTERVAL_S )
+        next if ready.nil?
+
+        conn = @listener.accept
+        @lock.synchronize { @handlers << Thread.new( conn ) {|_conn| handle( _conn, app_cfg ) } }
+      end
+    rescue Interrupt
+      # Foreground server stopped from its terminal
+    ensure
+      @listener.close
+      @file_wrapper.rm_f( socket )
+    end
+
+    @lock.synchronize { @handlers.dup }.each {|thread| thread.join }
+
+    if @reloading
+      log( "Changes detected; restarting" )
+      exec( RbConfig.ruby, @script, 'server', 'start', '--foreground', '--socket', socket )
+    end
+  end
+
+
+  def handle(conn, app_cfg)
+    conn.binmode
+    request = JSON.parse( conn.gets || '{}' )
+
+    case request['command']
+    when 'status'
+      BuildClient.write_frame( conn, BuildClient::FRAME_STDOUT, status_report() )
+      BuildClient.write_frame( conn, BuildClient::FRAME_EXIT, '0' )
+
+    when 'stop'
+      @stopping = true
+      BuildClient.write_frame( conn, BuildClient::FRAME_EXIT, '0' )
+
+    when 'build'
+      # Tell the client to retry after we restart with updated code
+      if @reloading or stale?( app_cfg )
+        BuildClient.write_frame( conn, BuildClient::FRAME_RELOAD, '' )
+      else
+        build( conn, request )
+      end
+    end
+
+  rescue StandardError => ex
+    log( "Request failed: #{ex.message}" )
+  ensure
+    conn.close
+    @lock.synchronize { @handlers.delete( Thread.current ) }
+  end
+
+
+  def build(conn, request)
+    out_r, out_w, err_r, err_w, pid = nil
+
+    # Serialize forks so no concurrent build inherits (and holds open) another build's pipes
+    @fork_lock.synchronize do
+      out_r, out_w = IO.pipe
+      err_r, err_w = IO.pipe
+
+      pid = fork do
+        @listener.close
+        out_r.close
+        err_r.close
+
+        # Build subprocesses (compilers, test fixtures, etc.) inherit these file descriptors
+        $stdout.reopen( out_w )
+        $stderr.reopen( err_w )
+        $stdout.sync = true
+        $stderr.sync = true
+
+        Dir.chdir( request['cwd'] )
+        ENV.replace( request['env'] )
+        # The launcher must build here rather than forward its command line back to us
+        ENV[BuildClient::DISABLE_ENV_VAR] = '1'
+        ARGV.replace( request['argv'] )
+
+        LAUNCHER_CONSTANTS.each do |name|
+          Object.send( :remove_const, name ) if Object.const_defined?( name )
+        end
+
+        # Run the launcher exactly as if invoked from the command line
+        load( @script )
+        exit( 0 )
+      end
+
+      out_w.close
+      err_w.close
+    end
+
+    @lock.synchronize { @builds += 1 }
+
+    relays = [[out_r, BuildClient::FRAME_STDOUT], [err_r, BuildClient::FRAME_STDERR]].map do |pipe, type|
+      Thread.new do
+        begin
+          loop do
+            chunk = pipe.readpartial( 16384 )
+            @lock.synchronize { BuildClient.write_frame( conn, type, chunk ) }
+          end
+        rescue EOFError
+          # Build closed its end of the pipe
+        rescue SystemCallError, IOError
+          # Client went away (e.g. Ctrl-C); don't leave an orphaned build running
+          Process.kill( 'TERM', pid ) rescue nil
+        end
+      end
+    end
+
+    relays.each {|thread| thread.join }
+    _, status = Process.wait2( pid )
+
+    BuildClient.write_frame( conn, BuildClient::FRAME_EXIT, (status.exitstatus || 1).to_s )
+  ensure
+    [out_r, err_r].each {|pipe| pipe.close if !pipe.nil? and !pipe.closed? }
+  end
+
+
+  def preload(app_cfg)
+    # Mirror the load paths the application's Rakefile sets up
+    $LOAD_PATH.unshift( File.join( app_cfg[:ceedling_vendor_path], 'unity/auto' ) )
+    $LOAD_PATH.unshift( File.join( app_cfg[:ceedling_vendor_path], 'cmock/lib' ) )
+    $LOAD_PATH.unshift( File.join( app_cfg[:ceedling_vendor_path], 'diy/lib' ) )
+    Dir.glob( File.join( app_cfg[:ceedling_lib_path], '**/' ) ).each {|dir| $LOAD_PATH.unshift( dir ) }
+
+    PRELOAD_LIBRARIES.each {|library| require( library ) }
+
+    config = project_config()
+
+    # A project that selects a different Ceedling application must load it fresh in each build
+    if !ENV['WHICH_CEEDLING'].nil? or !config.dig( :project, :which_ceedling ).nil?
+      log( "Project selects its own Ceedling application; preloading only libraries" )
+      return
+    end
+
+    files = Dir.glob( File.join( app_cfg[:ceedling_lib_path], '**/*.rb' ) )
+    # The Rakefile performs the build itself
+    files.delete( app_cfg[:ceedling_rakefile_filepath] )
+    files.map! {|file| File.expand_path( file ) }
+
+    files += plugin_files( app_cfg, config )
+
+    # Require order is unknown; retry files that depend on code not yet loaded until no progress is made
+    pending = files.sort()
+    loop do
+      failed = pending.reject do |file|
+        begin
+          require( file )
+        rescue NameError, LoadError
+          false
+        end
+      end
+
+      break if failed.empty? or failed.size == pending.size
+      pending = failed
+    end
+
+    log( "Preloaded #{files.size} Ceedling & plugin source files" )
+  end
+
+
+  def plugin_files(app_cfg, config)
+    enabled = config.dig( :plugins, :enabled ) || []
+    load_paths = (config.dig( :plugins, :load_paths ) || []) + [app_cfg[:ceedling_plugins_path]]
+
+    files = []
+    enabled.each do |plugin|
+      load_paths.each do |path|
+        lib = File.join( path, plugin.to_s, 'lib' )
+        next if !@file_wrapper.directory?( lib )
+
+        $LOAD_PATH.unshift( lib )
+        files += Dir.glob( File.join( lib, '*.rb' ) ).map {|file| File.expand_path( file ) }
+        break
+      end
+    end
+
+    return files
+  end
+
+
+  def project_config()
+    return {} if !@file_wrapper.exist?( @project_filepath )
+
+    begin
+      config = @yaml_wrapper.load( @project_filepath )
+      return config.is_a?( Hash ) ? config : {}
+    rescue StandardError
+      # Builds will report any problems with the project file
+      return {}
+    end
+  end
+
+
+  # Modification times of the project file plus all Ceedling Ruby code in this process
+  def fingerprint(app_cfg)
+    root = File.expand_path( app_cfg[:ceedling_root_path] )
+    files = $LOADED_FEATURES.select {|file| file.start_with?( root ) }
+    files << @project_filepath
+
+    return files.map {|file| [file, (File.mtime( file ) rescue nil)] }.to_h
+  end
+
+
+  def stale?(app_cfg)
+    return fingerprint( app_cfg ) != @fingerprint
+  end
+
+
+  def status_report()
+    uptime = (Time.now - @started).round()
+
+    return <<~STATUS
+      Ceedling build server
+       > PID: #{Process.pid}
+       > Working directory: #{Dir.pwd()}
+       > Project file: #{@project_filepath}
+       > Uptime: #{uptime} seconds
+       > Builds served: #{@builds}
+       > Builds in progress: #{@lock.synchronize { @handlers.size } - 1}
+    STATUS
+  end
+
+
+  def log(msg)
+    $stdout.puts( "#{Time.now} | #{msg}" )
+  end
+
+end
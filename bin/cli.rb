@@ -7,6 +7,7 @@
 
 require 'thor'
 require 'ceedling/constants' # From Ceedling application
+require 'build_client' # Build server socket defaults
 
 ##
 ## Command Line Handling
@@ -307,6 +308,14 @@ module CeedlingTasks
     # :lazy_default allows us to check for missing parameters (if no filepath given Thor unhelpfully provides the flag name as its value)
     method_option :logfile, :type => :string, :aliases => ['-l'], :default => '', :lazy_default => CLI_MISSING_PARAMETER_DEFAULT,
                   :desc => "Enables logging to specified filepath"
+    method_option :log_format, :type => :string, :default => 'text', :enum => ['text', 'json'],
+                  :desc => "Log file format (`json` writes one structured record per line)"
+    method_option :progress, :type => :boolean, :default => false,
+                  :desc => "Show a compact progress line in place of per-file console messages"
+    method_option :profile, :type => :boolean, :default => false,
+                  :desc => "Report time spent per build stage, parallel item, and tool"
+    method_option :explain, :type => :boolean, :default => false,
+                  :desc => "Report why each test build artifact was rebuilt and the build's critical path"
     method_option :graceful_fail, :type => :boolean, :default => nil, :desc => "Force exit code of 0 for unit test failures"
     method_option :test_case, :type => :string, :default => '', :lazy_default => CLI_MISSING_PARAMETER_DEFAULT,
                   :desc => "Filter for individual unit test names"
@@ -337,6 +346,27 @@ module CeedlingTasks
       • `If --log and --logfile are both specified, --logfile will set the log file path.
       If --no-log and --logfile are both specified, no logging will occur.
 
+      • `--log-format json` writes the log file as JSON lines. Each record
+      includes the build stage and test it belongs to. Tool executions are
+      recorded with their durations. The default log filepath becomes
+      <build path>/#{DEFAULT_BUILD_LOGS_PATH}/#{DEFAULT_CEEDLING_STRUCTURED_LOGFILE}.
+
+      • `--progress` replaces the console messages of parallel build steps with
+      a single status line (step, files done, active jobs, and estimated time
+      remaining) when the console is a terminal and verbosity is no higher than
+      normal. Errors and warnings are still printed. Log files receive every message.
+
+      • `--profile` times each build stage, each item of parallel work, and each
+      tool execution. A summary sorted by duration is printed at the end of the
+      build and written to <build path>/#{DEFAULT_BUILD_LOGS_PATH}/profile.txt along
+      with a trace (profile.json) viewable in Perfetto or chrome://tracing.
+
+      • `--explain` records why each test build artifact was rebuilt (missing
+      output, changed input, changed command, or forced) and reports the
+      critical path through the test pipeline (context → mocks → runner →
+      objects → link → run). Explanations are written to
+      <build path>/#{DEFAULT_BUILD_LOGS_PATH}/explain.txt.
+
       • #{LONGDOC_RUBY_REPLACEMENT_FLAG}
       LONGDESC
     ) )
@@ -579,6 +609,58 @@ module CeedlingTasks
     end
 
 
+    desc "server ACTION", "Manage a background build server (ACTION: start, stop, status)"
+    method_option :socket, :type => :string, :default => nil, :desc => "Filepath of the server's Unix domain socket"
+    method_option :foreground, :type => :boolean, :default => false, :desc => "Run server in the foreground rather than as a daemon (`start` only)"
+    method_option :debug, :type => :boolean, :default => false, :hide => true
+    long_desc( CEEDLING_HANDOFF_OBJECTS[:loginator].sanitize(
+      <<-LONGDESC
+      `ceedling server` manages an opt-in background build server for the project
+      in your working directory.
+
+      A running server preloads Ruby, Thor, Rake, the Ceedling application, and
+      your enabled plugins. While it is listening, any other `ceedling` command line
+      issued from the same working directory is forwarded to it. The build runs in
+      a fresh process forked from the server’s warm state, and its console output
+      and exit code are returned to your shell. Frequent small builds (e.g. an IDE
+      running a single test) skip nearly all startup time.
+
+      ACTION is one of:
+
+      • `start` launches the server as a daemon. Server logging is written alongside
+      the socket in a file with a `.log` extension.
+
+      • `stop` shuts down the server.
+
+      • `status` reports on a running server.
+
+      The server restarts itself whenever your project file or Ceedling’s own code
+      changes. Mixins and all other configuration are reprocessed for every build.
+
+      Notes on Optional Flags:
+
+      • `--socket` sets the socket filepath. The default is #{BuildClient::DEFAULT_SOCKET}
+      in your working directory. The environment variable #{BuildClient::SOCKET_ENV_VAR}
+      does the same for both the server and forwarding clients.
+
+      • Set the environment variable #{BuildClient::DISABLE_ENV_VAR} to bypass a running
+      server for a single command line.
+
+      NOTE: The build server relies on Unix domain sockets and process forking.
+      It is not available on Windows.
+      LONGDESC
+    ) )
+    def server(action)
+      # Get unfrozen copies so we can add / modify
+      _options = options.dup()
+      _options[:socket] = options[:socket].dup() if !options[:socket].nil?
+
+      _options[:verbosity] = options[:debug] ? Verbosity::DEBUG : nil
+
+      @handler.server( ENV, @app_cfg, _options, action )
+    end
+
+
     desc "version", "Display version details of Ceedling components"
     long_desc( CEEDLING_HANDOFF_OBJECTS[:loginator].sanitize(
       <<-LONGDESC
@@ -10,12 +10,13 @@ require 'mixins' # Built-in Mixins
 require 'ceedling/constants' # From Ceedling application
 require 'ceedling/rake_app/rake_task_registry' # From Ceedling application
 require 'versionator' # Outisde DIY context
+require 'build_client' # Outside DIY context
 
 class CliHandler
 
   DOCS_SUBDIR = 'docs'
 
-  constructor :configinator, :projectinator, :cli_helper, :path_validator, :rake_task_registry, :actions_wrapper, :loginator
+  constructor :configinator, :projectinator, :cli_helper, :path_validator, :rake_task_registry, :actions_wrapper, :build_server, :loginator
 
   # Override to prevent exception handling from walking & stringifying the object variables.
   # Object variables are lengthy and produce a flood of output.
@@ -205,7 +206,8 @@ class CliHandler
     )
 
     logging_path = @helper.process_logging_path( config )
-    log_filepath = @helper.process_log_filepath( logging_path, options[:log], options[:logfile] )
+    log_format = (options[:log_format] || 'text').to_sym
+    log_filepath = @helper.process_log_filepath( logging_path, options[:log], options[:logfile], log_format )
 
     @loginator.console( " > Logfile: #{log_filepath}" ) if !log_filepath.empty?
 
@@ -213,6 +215,10 @@ class CliHandler
     app_cfg.set_project_config( config )
     app_cfg.set_logging_path( logging_path )
     app_cfg.set_log_filepath( log_filepath )
+    app_cfg.set_log_format( log_format )
+    app_cfg.set_progress( options[:progress] ? true : false )
+    app_cfg.set_profile( options[:profile] ? true : false )
+    app_cfg.set_explain( options[:explain] ? true : false )
     app_cfg.set_include_test_case( options[:test_case] )
     app_cfg.set_exclude_test_case( options[:exclude_test_case] )
 
@@ -484,6 +490,24 @@ class CliHandler
   end
 
 
+  def server(env, app_cfg, options, action)
+    @helper.set_verbosity( options[:verbosity] )
+
+    socket = options[:socket] || BuildClient.socket_path( env )
+
+    case action
+    when 'start'
+      @build_server.start( app_cfg:app_cfg, socket:socket, foreground:options[:foreground] )
+    when 'stop'
+      @build_server.stop( socket:socket )
+    when 'status'
+      @build_server.status( socket:socket )
+    else
+      raise Thor::Error.new( "Unknown server action '#{action}' (expected start, stop, or status)" )
+    end
+  end
+
+
   def version(env, app_cfg)
     # Versionator is not needed to persist. So, it's not built in the DIY collection.
 
@@ -265,7 +265,7 @@ class CliHelper
   end
 
 
-  def process_log_filepath(logging_path, log, logfile)
+  def process_log_filepath(logging_path, log, logfile, format=:text)
     filepath = nil
 
     # --log => nil (default / not set), false (explicitly disabled), true (explicitly enabled)
@@ -278,7 +278,7 @@ class CliHelper
       filepath = logfile
     # If logging is enabled without a filepath in --logfile, then set up the default path
     elsif log
-      filepath = File.join( logging_path, DEFAULT_CEEDLING_LOGFILE )
+      filepath = File.join( logging_path, (format == :json) ? DEFAULT_CEEDLING_STRUCTURED_LOGFILE : DEFAULT_CEEDLING_LOGFILE )
     elsif logfile.empty?
       return ''
     end
@@ -10,7 +10,7 @@ require 'parallel'
 
 class Batchinator
 
-  constructor :configurator, :loginator, :reportinator
+  constructor :configurator, :loginator, :reportinator, :progress_renderer, :profiler, :explainer
 
   def setup
     @queue = Queue.new
@@ -18,6 +18,9 @@ class Batchinator
 
   # Neaten up a build step with progress message and some scope encapsulation
   def build_step(msg, heading: true, &block)
+    # Build steps run one at a time; label structured log entries with the current step
+    @loginator.stage = msg
+
     if heading
       msg = @reportinator.generate_heading( @loginator.decorate( msg, LogLabels::RUN ) )
     else # Progress message
@@ -34,6 +37,11 @@ class Batchinator
   #  - Spin up a number of worker threads within constraints of project file config and amount of work
   #  - Each worker thread consumes one item from queue and runs the block against its details
   #  - When the queue is empty, the worker threads wind down
+  #
+  # Workload :ruby is Ruby-CPU-bound work (e.g. mock generation) that threads cannot run in
+  # parallel. If so configured, it runs in forked worker processes instead (see `map_in_processes()`).
+  # Its block must then return any results as serializable values (state changed by a worker
+  # process is lost) for the caller to merge; results are returned in the order of `things`.
   def exec(workload:, things:, &job_block)
 
     batch_results = []
@@ -43,7 +51,7 @@ class Batchinator
       # Determine number of worker threads to run
       workers = 1
       case workload
-      when :compile
+      when :compile, :ruby
         workers = @configurator.project_compile_threads
       when :test
         workers = @configurator.project_test_threads
@@ -51,11 +59,31 @@ class Batchinator
         raise NameError.new("Unrecognized batch workload type: #{workload}")
       end
 
+      @progress_renderer.start_batch( total: things.size )
+
       # Perform the actual parallelized work and collect the results and timing
-      batch_results = Parallel.map(things, in_threads: workers) do |key, value| 
-        this_results = ''
-        this_elapsed = Benchmark.realtime { this_results = job_block.call(key, value) }
-        [this_results, this_elapsed]
+      begin
+        if (workload == :ruby) and worker_processes?( workers, things )
+          batch_results = exec_in_processes( things, workers, &job_block )
+        else
+          batch_results = Parallel.map(things, in_threads: workers) do |key, value| 
+            this_results = ''
+            @progress_renderer.job_started()
+            this_elapsed = Benchmark.realtime do
+              test = batch_item_test( key, value )
+              file = batch_item_file( key, value )
+              @profiler.span( 'item', category: :item, args: {:test => test, :file => file} ) do
+                @explainer.item( test: test, file: file ) do
+                  @loginator.with_fields( test: test ) { this_results = job_block.call(key, value) }
+                end
+              end
+            end
+            @progress_renderer.job_finished()
+            [this_results, this_elapsed]
+          end
+        end
+      ensure
+        @progress_renderer.finish_batch()
       end
 
       # Separate the elapsed time and results
@@ -72,5 +100,187 @@ class Batchinator
 
     batch_results
   end
+
+  ### Private ###
+
+  private
+
+  # Worker processes are used if configured, possible (fork is unavailable on Windows & JRuby),
+  # and worthwhile. Not while explaining a build -- its records are kept by this process.
+  def worker_processes?(workers, things)
+    return false if @configurator.project_ruby_workers != :processes
+    return false if !Process.respond_to?( :fork )
+    return false if @explainer.enabled?
+    return (workers > 1) && (things.size > 1)
+  end
+
+  # Run `job_block` for each of `things` in worker processes. Logging, progress, and profiling
+  # of each item are handed back to this process as it finishes.
+  def exec_in_processes(things, workers, &job_block)
+    items = things.to_a
+
+    job = proc do |key, value|
+      this_elapsed = 0.0
+      this_results, logs = @loginator.capture do
+        result = nil
+        this_elapsed = Benchmark.realtime do
+          @loginator.with_fields( test: batch_item_test( key, value ) ) { result = job_block.call(key, value) }
+        end
+        result
+      end
+      [this_results, this_elapsed, logs]
+    end
+
+    finished = proc do |item, worker, (_, this_elapsed, logs)|
+      key, value = item
+      @loginator.replay( logs )
+      @profiler.record( 'item',
+        category: :item,
+        duration: this_elapsed,
+        track:    worker,
+        args:     {:test => batch_item_test( key, value ), :file => batch_item_file( key, value )}
+      )
+      @progress_renderer.job_finished()
+    end
+
+    results = map_in_processes( items, workers, started: proc { @progress_renderer.job_started() }, finished: finished, &job )
+
+    return results.map {|this_results, this_elapsed, _| [this_results, this_elapsed]}
+  end
+
+  # Fork up to `workers` processes, hand each one item (by index) at a time, and collect each
+  # item's Marshal'ed result. `started` and `finished` are called in this process as each item
+  # is handed out and its result returns. A failing item stops further items from being handed
+  # out; its exception is raised once the workers have exited.
+  #
+  # Workers end with `exit!` -- this process's at_exit handlers (e.g. Rake's END block) must
+  # run only in this process.
+  def map_in_processes(items, workers, started:, finished:, &job)
+    results = Array.new( items.size )
+    pending = (0...items.size).to_a
+    pool = []
+    error = nil
+
+    [workers, items.size].min.times do |number|
+      jobs_read, jobs_write = IO.pipe
+      results_read, results_write = IO.pipe
+
+      pid = Process.fork do
+        begin
+          jobs_write.close
+          results_read.close
+          pool.each {|worker| worker[:jobs].close; worker[:results].close}
+
+          while (line = jobs_read.gets)
+            reply =
+              begin
+                [:ok, job.call( items[line.to_i] )]
+              rescue Exception => ex
+                [:error, ex]
+              end
+
+            results_write.write( serialize( reply ) )
+            results_write.flush
+          end
+        ensure
+          exit!( 0 )
+        end
+      end
+
+      jobs_read.close
+      results_write.close
+      pool << {:pid => pid, :number => number, :jobs => jobs_write, :results => results_read, :index => nil}
+    end
+
+    dispatch = proc do |worker|
+      worker[:index] = pending.shift
+      if worker[:index].nil?
+        worker[:jobs].close
+      else
+        started.call()
+        worker[:jobs].puts( worker[:index] )
+      end
+    end
+
+    pool.each {|worker| dispatch.call( worker )}
+
+    while !(busy = pool.reject {|worker| worker[:index].nil?}).empty?
+      ready, _ = IO.select( busy.map {|worker| worker[:results]} )
+
+      ready.each do |io|
+        worker = busy.find {|_worker| _worker[:results].equal?( io )}
+        index = worker[:index]
+        status, value = deserialize( io )
+
+        if status.nil?
+          error ||= CeedlingException.new( "Worker process #{worker[:pid]} exited unexpectedly" )
+          worker[:index] = nil
+          next
+        end
+
+        if status == :error
+          error ||= value
+          pending.clear()
+        else
+          results[index] = value
+          finished.call( items[index], worker[:number], value )
+        end
+
+        dispatch.call( worker )
+      end
+    end
+
+    raise error if !error.nil?
+
+    return results
+  ensure
+    pool.each do |worker|
+      worker[:jobs].close if !worker[:jobs].closed?
+      worker[:results].close if !worker[:results].closed?
+      Process.wait( worker[:pid] ) rescue nil
+    end
+  end
+
+  # Length-prefixed Marshal'ed data -- a result that cannot be serialized becomes an exception
+  def serialize(reply)
+    data =
+      begin
+        Marshal.dump( reply )
+      rescue TypeError => ex
+        status, value = reply
+        cause = (status == :error) ? "#{value.class}: #{value.message}" : ex.message
+        Marshal.dump( [:error, CeedlingException.new( "Batch item result could not be returned from a worker process (#{cause})" )] )
+      end
+
+    return [data.bytesize].pack( 'N' ) + data
+  end
+
+  # [status, value] or nil if the worker is gone
+  def deserialize(io)
+    size = io.read( 4 )
+    return nil if size.nil? or (size.bytesize < 4)
+
+    data = io.read( size.unpack1( 'N' ) )
+    return Marshal.load( data )
+  end
+
+  # Name of the test a batch item belongs to (for structured logging), if any:
+  #  - Testables hash entries (name => testable)
+  #  - Work item hashes referencing a testable
+  def batch_item_test(key, value)
+    testable = value.nil? ? (key[:testable] if key.is_a?( Hash )) : value
+    return testable.name.to_s if testable.respond_to?( :name )
+    return key[:test].to_s if key.is_a?( Hash ) and !key[:test].nil?
+    return nil
+  end
+
+  # File (or mock) a batch item works on (for profiling & explanations), if any:
+  #  - Filepaths (e.g. release build objects)
+  #  - Work item hashes naming an object, mock, or Partial file
+  def batch_item_file(key, value)
+    return key if key.is_a?( String )
+    return nil if !key.is_a?( Hash )
+    return key[:obj] || key[:name] || (key[:config].filepath if key[:config].respond_to?( :filepath ))
+  end
 end
 
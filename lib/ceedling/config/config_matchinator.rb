@@ -19,6 +19,13 @@ class ConfigMatchinator
 
   constructor :configurator, :loginator, :reportinator
 
+  def setup()
+    # Matcher hash (by identity) => { :matchers => compiled matchers, :results => memoized matches }.
+    # Configuration is complete before any matching, so a hash's matchers never change once compiled.
+    @compiled = {}.compare_by_identity
+    @lock = Mutex.new
+  end
+
   def config_include?(primary:, secondary:, tertiary:nil)
     # Create configurator accessor method
     accessor = (primary.to_s + '_' + secondary.to_s).to_sym
@@ -90,8 +97,6 @@ class ConfigMatchinator
 
   # Note: This method only relevant if hash includes test filepath matching keys
   def matches?(hash:, filepath:, section:, context:, operation:nil)
-    _values = []
-
     # Sanity check
     if filepath.nil?
       path = generate_matcher_path(section, context, operation)
@@ -99,55 +104,18 @@ class ConfigMatchinator
       raise CeedlingException.new(error)
     end
 
-    # Iterate through every hash touple [matcher key, values array]
-    # In prioritized order match test filepath against each matcher key.
-    # This order matches on special patterns first to ensure no funny business with simple substring matching 
-    #  1. All files wildcard ('*')
-    #  2. Regex (/.../)
-    #  3. Wildcard filepath matching (e.g. 'name*')
-    #  4. Any filepath matching (substring matching)
-    #
-    # Each element of the collected _values array will be an array of values.
-
-    hash.each do |matcher, values|
-      matched = false
-      _matcher = matcher.to_s.strip
+    compiled = @lock.synchronize { @compiled[hash] ||= { :matchers => compile_matchers( hash ), :results => {} } }
 
-      # 1. Try gross wildcard matching -- return values for all test filepaths if '*' is the matching key
-      if ('*' == _matcher)
-        matched = true
-
-      # 2. Try regular expression matching against all values matching keys that are regexes (ignore if not a valid regex)
-      #    Note: We use logical AND here so that we get a meaningful fall-through condition.
-      #          Nesting the actual regex matching beneath validity checking improperly catches unmatched regexes
-      elsif (regex?(_matcher)) and (!(form_regex(_matcher).match(filepath)).nil?)
-        matched = true
-
-      # 3. Try wildcard matching -- return values for any test filepath that matches with '*' expansion
-      #    Treat matcher as a regex:
-      #      1. Escape any regex characters (e.g. '-')
-      #      2. Convert any now escaped '\*'s into '.*'
-      #      3. Match filepath against regex-ified matcher
-      elsif (filepath =~ /#{Regexp.escape(matcher).gsub('\*', '.*')}/)
-        matched = true
-
-      # 4. Try filepath literal matching (including substring matching) with each matching key
-      #    Note: (3) will do this if the matcher key lacks a '*', but this is a just-in-case backup
-      elsif (filepath.include?(_matcher))
-        matched = true
-      end        
+    # Per-file flags and defines are looked up for every file and operation of every build step
+    key = [filepath, section, context, operation]
+    values = @lock.synchronize { compiled[:results][key] }
 
-      if matched
-        _values += values
-        matched_notice(section:section, context:context, operation:operation, matcher:_matcher, filepath:filepath)
-      else # No match
-        path = generate_matcher_path(section, context, operation)
-        @loginator.lazy( Verbosity::DEBUG ) { "#{path} ↳ `#{matcher}` did not match #{filepath}" }
-      end
+    if values.nil?
+      values = match( compiled[:matchers], filepath:filepath, section:section, context:context, operation:operation ).freeze
+      @lock.synchronize { compiled[:results][key] = values }
     end
 
-    # Flatten to handle list-nested YAML aliasing (should have already been flattened during validation)
-    return _values.flatten
+    return values.dup()
   end
 
   ### Class Methods ###
@@ -216,6 +184,61 @@ class ConfigMatchinator
 
   private
 
+  # Prebuild everything matching needs from each [matcher key, values array] touple -- in hash order.
+  # Each touple's matching follows a prioritized order (see `match()`).
+  def compile_matchers(hash)
+    return hash.map do |matcher, values|
+      _matcher = matcher.to_s.strip
+
+      compiled = {
+        :matcher  => _matcher,
+        :values   => values,
+        :all      => ('*' == _matcher),
+        :regex    => (regex?( _matcher ) ? form_regex( _matcher ) : nil),
+        :wildcard => nil
+      }
+
+      # Matchers with '*' are regex-ified:
+      #  1. Escape any regex characters (e.g. '-')
+      #  2. Convert any now escaped '\*'s into '.*'
+      # Otherwise, the regex-ified matcher is simply the matcher text -- plain substring matching is equivalent
+      compiled[:wildcard] = Regexp.new( Regexp.escape( matcher.to_s ).gsub( '\*', '.*' ) ) if matcher.to_s.include?( '*' )
+
+      compiled
+    end
+  end
+
+  # In prioritized order match test filepath against each compiled matcher key.
+  # This order matches on special patterns first to ensure no funny business with simple substring matching
+  #  1. All files wildcard ('*')
+  #  2. Regex (/.../)
+  #  3. Wildcard filepath matching (e.g. 'name*')
+  #  4. Any filepath matching (substring matching)
+  #
+  # Each element of the collected _values array will be an array of values.
+  def match(matchers, filepath:, section:, context:, operation:)
+    _values = []
+
+    matchers.each do |compiled|
+      matched =
+        compiled[:all] ||
+        (!compiled[:regex].nil? && compiled[:regex].match?( filepath )) ||
+        (!compiled[:wildcard].nil? && compiled[:wildcard].match?( filepath )) ||
+        filepath.include?( compiled[:matcher] )
+
+      if matched
+        _values += compiled[:values]
+        matched_notice(section:section, context:context, operation:operation, matcher:compiled[:matcher], filepath:filepath)
+      else # No match
+        path = generate_matcher_path(section, context, operation)
+        @loginator.lazy( Verbosity::DEBUG ) { "#{path} ↳ `#{compiled[:matcher]}` did not match #{filepath}" }
+      end
+    end
+
+    # Flatten to handle list-nested YAML aliasing (should have already been flattened during validation)
+    return _values.flatten
+  end
+
   def matched_notice(section:, context:, operation:, matcher:, filepath:)
     path = generate_matcher_path(section, context, operation)
     @loginator.lazy( Verbosity::OBNOXIOUS ) { "#{path} ↳ #{matcher} matched #{filepath}" }
@@ -757,6 +757,8 @@ class Configurator
     blotter &= @configurator_setup.validate_backtrace( config )
     blotter &= @configurator_setup.validate_threads( config )
     blotter &= @configurator_setup.validate_partials( config )
+    blotter &= @configurator_setup.validate_test_build( config )
+    blotter &= @configurator_setup.validate_release_build( config )
     blotter &= @configurator_setup.validate_plugins( config )
 
     # Informational notices
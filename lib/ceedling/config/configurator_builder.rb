@@ -130,6 +130,7 @@ class ConfiguratorBuilder
       [:project_test_build_output_path,         File.join(project_build_tests_root, 'out'),               true ],
       [:project_test_build_cache_path,          File.join(project_build_tests_root, 'cache'),             true ],
       [:project_test_dependencies_path,         File.join(project_build_tests_root, 'dependencies'),      true ],
+      [:project_test_response_files_path,       File.join(project_build_tests_root, 'response_files'),    in_hash[:project_use_response_files] ],
 
       [:project_build_vendor_unity_path,        File.join(project_build_vendor_root, 'unity', 'src'),       true ],
       # Always include a Ceedling path (even if empty) as we need a search path present for certain preprocessing steps
@@ -141,6 +142,7 @@ class ConfiguratorBuilder
       [:project_release_build_cache_path,       File.join(project_build_release_root, 'cache'),             in_hash[:project_release_build] ],
       [:project_release_build_output_path,      File.join(project_build_release_root, 'out'),               in_hash[:project_release_build] ],
       [:project_release_dependencies_path,      File.join(project_build_release_root, 'dependencies'),      in_hash[:project_release_build] ],
+      [:project_release_response_files_path,    File.join(project_build_release_root, 'response_files'),    (in_hash[:project_release_build] && in_hash[:project_use_response_files]) ],
 
       [:project_log_path,                       logging_path, true ],
 
@@ -684,7 +684,7 @@ class ConfiguratorSetup
   def validate_backtrace(config)
     valid = true
 
-    options = [:none, :simple, :gdb]
+    options = [:none, :simple, :bisect, :gdb]
 
     use_backtrace = config[:project][:use_backtrace]
 
@@ -696,6 +696,19 @@ class ConfiguratorSetup
       valid = false
     end
 
+    # A customized gdb tool from before all test cases ran in one gdb session takes a Unity filter
+    # argument (${3}) that is no longer provided -- it would debug the whole test executable instead
+    tool = config.dig( :tools, :test_backtrace_gdb )
+    if (use_backtrace == :gdb) and !tool.nil? and tool[:arguments].to_a.any? {|arg| arg.to_s.include?( '${3}' ) }
+      walk = @reportinator.generate_config_walk( [:tools, :test_backtrace_gdb, :arguments] )
+
+      msg = "#{walk} references ${3}, a Unity filter argument no longer provided. " +
+            "Ceedling now runs every test case in one gdb session from a script it generates. " +
+            "Remove ${3} and any `--eval-command run`, and pass only the script (`--command \"${1}\"`) and the test executable (`--args ${2}`)."
+      @loginator.log( msg, Verbosity::ERRORS )
+      valid = false
+    end
+
     return valid
   end
 
@@ -741,6 +754,13 @@ class ConfiguratorSetup
       valid = false
     end
 
+    walk = @reportinator.generate_config_walk( [:project, :ruby_workers] )
+
+    if ![:threads, :processes].include?( config[:project][:ruby_workers] )
+      @loginator.log( "#{walk} is ':#{config[:project][:ruby_workers]}' but must be one of {:threads, :processes}", Verbosity::ERRORS )
+      valid = false
+    end
+
     return valid
   end
 
@@ -770,6 +790,99 @@ class ConfiguratorSetup
     return valid
   end
 
+  def validate_test_build(config)
+    valid = true
+
+    options = [:json, :yaml]
+
+    results_format = config[:test_build][:results_format]
+
+    if !options.include?( results_format )
+      walk = @reportinator.generate_config_walk( [:test_build, :results_format] )
+
+      msg = "#{walk} is ':#{results_format}' but must be one of {#{options.map{|o| ':' + o.to_s()}.join(', ')}}"
+      @loginator.log( msg, Verbosity::ERRORS )
+      valid = false
+    end
+
+    results_stdout_limit = config[:test_build][:results_stdout_limit]
+
+    walk = @reportinator.generate_config_walk( [:test_build, :results_stdout_limit] )
+
+    case results_stdout_limit
+    when Integer
+      if results_stdout_limit < 1
+        @loginator.log( "#{walk} must be greater than 0", Verbosity::ERRORS )
+        valid = false
+      end
+    else
+      @loginator.log( "#{walk} is not an integer", Verbosity::ERRORS )
+      valid = false
+    end
+
+    valid &= validate_jumbo_build( config, :test_build )
+
+    minimal_search_paths = config[:test_build][:minimal_search_paths]
+
+    if ![true, false].include?( minimal_search_paths )
+      walk = @reportinator.generate_config_walk( [:test_build, :minimal_search_paths] )
+      @loginator.log( "#{walk} is '#{minimal_search_paths}' but must be one of {true, false}", Verbosity::ERRORS )
+      valid = false
+    end
+
+    return valid
+  end
+
+  def validate_release_build(config)
+    valid = true
+
+    options = [:timestamp, :checksum]
+
+    change_detection = config[:release_build][:change_detection]
+
+    if !options.include?( change_detection )
+      walk = @reportinator.generate_config_walk( [:release_build, :change_detection] )
+
+      msg = "#{walk} is ':#{change_detection}' but must be one of {#{options.map{|o| ':' + o.to_s()}.join(', ')}}"
+      @loginator.log( msg, Verbosity::ERRORS )
+      valid = false
+    end
+
+    valid &= validate_jumbo_build( config, :release_build )
+
+    return valid
+  end
+
+  # `:jumbo_size` & `:jumbo_exclude` of `:test_build` or `:release_build`
+  def validate_jumbo_build(config, section)
+    valid = true
+
+    jumbo_size = config[section][:jumbo_size]
+
+    walk = @reportinator.generate_config_walk( [section, :jumbo_size] )
+
+    case jumbo_size
+    when Integer
+      if jumbo_size < 0
+        @loginator.log( "#{walk} must not be negative", Verbosity::ERRORS )
+        valid = false
+      end
+    else
+      @loginator.log( "#{walk} is not an integer", Verbosity::ERRORS )
+      valid = false
+    end
+
+    jumbo_exclude = config[section][:jumbo_exclude]
+
+    if !jumbo_exclude.is_a?( Array ) or !jumbo_exclude.all? {|pattern| pattern.is_a?( String )}
+      walk = @reportinator.generate_config_walk( [section, :jumbo_exclude] )
+      @loginator.log( "#{walk} must be a list of filenames or filepath glob patterns", Verbosity::ERRORS )
+      valid = false
+    end
+
+    return valid
+  end
+
   def validate_plugins(config)
     missing_plugins =
       Set.new( config[:plugins][:enabled] ) -
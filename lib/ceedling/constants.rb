@@ -71,6 +71,9 @@ end
 EXTENSION_WIN_EXE     = '.exe'
 EXTENSION_NONWIN_EXE  = '.out'
 
+# Digest of the contents an object was built from (release build `:change_detection` ↳ `:checksum`)
+EXTENSION_FINGERPRINT = '.fingerprint'
+
 # Vendor frameworks, generated mocks, generated runners are always .c files
 EXTENSION_CORE_HEADER = '.h'
 EXTENSION_CORE_SOURCE = '.c'
@@ -78,6 +81,7 @@ EXTENSION_CORE_SOURCE = '.c'
 CEEDLING_HEADER_FILENAME = 'ceedling.h'
 CEEDLING_HEADER_FILEPATH = CEEDLING_HEADER_FILENAME # lib/ceedling/
 PARTIAL_FILENAME_PREFIX  = 'ceedling_partial_'
+JUMBO_FILENAME_PREFIX    = 'ceedling_jumbo_'
 
 class PATTERNS
   GLOB = /[\*\?\{\}\[\]]/
@@ -148,8 +152,15 @@ CMOCK_C_FILE    = 'cmock.c'
 CMOCK_H_FILE    = 'cmock.h'
 
 DEFAULT_CEEDLING_LOGFILE = 'ceedling.log'
+DEFAULT_CEEDLING_STRUCTURED_LOGFILE = 'ceedling.jsonl'
 
 BACKTRACE_GDB_SCRIPT_FILE = 'backtrace.gdb'
+# Per-executable gdb session script (runs each crashed test case in turn) and its run marker
+BACKTRACE_GDB_SESSION_EXTENSION = '.backtrace.gdb'
+BACKTRACE_GDB_SESSION_MARKER = '==== Ceedling backtrace run'
+
+# Bytes of a test executable's output retained in memory (beyond a rolling tail) while its results are parsed as it runs
+TEST_OUTPUT_CAPTURE_LIMIT = 4 * 1024 * 1024
 
 INPUT_CONFIGURATION_CACHE_FILE = 'input.yml'   unless defined?(INPUT_CONFIGURATION_CACHE_FILE)     # input configuration file dump
 DEFINES_DEPENDENCY_CACHE_FILE  = 'defines_dependency.yml' unless defined?(DEFINES_DEPENDENCY_CACHE_FILE) # preprocessor definitions for files
@@ -179,6 +190,15 @@ PREPROCESS_RAW_DIRECTIVES_ONLY_DIR = 'directives_only/raw'
 BUILD_OUT_DIR          = 'out'
 BUILD_RESULTS_DIR      = 'results'
 BUILD_DEPENDENCIES_DIR = 'dependencies'
+BUILD_CACHE_DIR        = 'cache'
+
+SEARCH_PATHS_CACHE_FILENAME = 'search_paths.yml'
+
+PROFILE_SUMMARY_FILENAME = 'profile.txt'
+PROFILE_TRACE_FILENAME   = 'profile.json'
+
+EXPLAIN_REPORT_FILENAME   = 'explain.txt'
+EXPLAIN_COMMANDS_FILENAME = 'explain_commands.json'
 
 NULL_FILE_PATH = '/dev/null'
 
@@ -69,9 +69,10 @@ DEFAULT_TEST_FIXTURE_SIMPLE_BACKTRACE_TOOL = {
   :name => 'default_test_fixture_simple_backtrace'.freeze,
   :optional => false.freeze,
   :arguments => [
-    # Test case matching flag and (quoted) value, fully composed by the caller as
-    # either `-n "<exact name>"` or `-f "<base name>"` -- see
-    # GeneratorTestResultsBacktrace#unity_filter_arg.
+    # Test case matching flag and (quoted) value, fully composed by the caller as either:
+    #  - `-n "<name>[,<name>...]"` -- exact names of one or more non-parameterized test cases
+    #  - `-f "<base name>("` -- all parameter sets of a single parameterized test case
+    # See GeneratorTestResultsBacktrace#unity_filter_arg.
     '${2}'.freeze
     ].freeze
   }
@@ -201,14 +202,12 @@ DEFAULT_TEST_BACKTRACE_GDB_TOOL = {
   :arguments => [
     '-q'.freeze,
     '--batch'.freeze,
-    '--eval-command run'.freeze,
-    "--command \"${1}\"".freeze, # Debug script file to run
+    # Generated session script that runs each test case (group) in turn, with
+    # its own Unity filter arguments, and collects backtraces for any crashes --
+    # see GeneratorTestResultsBacktrace#gdb_session_script.
+    "--command \"${1}\"".freeze,
     '--args'.freeze,
-    '${2}'.freeze,               # Test executable
-    # Test case matching flag and (quoted) value, fully composed by the caller as
-    # either `-n "<exact name>"` or `-f "<base name>"` -- see
-    # GeneratorTestResultsBacktrace#unity_filter_arg.
-    '${3}'.freeze
+    '${2}'.freeze                # Test executable
     ].freeze
   }
 
@@ -276,15 +275,23 @@ DEFAULT_CEEDLING_PROJECT_CONFIG = {
     :use_test_preprocessor => :none,
     :compile_threads => 1,
     :test_threads => 1,
+    :ruby_workers => :threads,
     :test_file_prefix => 'test_',
     :release_build => false,
-    :use_backtrace => :simple
+    :use_backtrace => :simple,
+    :use_response_files => false
     },
 
   :release_build => {
     # :output is set while building configuration -- allows smart default system-dependent file extension handling
     :use_assembly => false,
-    :artifacts => []
+    :artifacts => [],
+    # How changes to sources & headers listed in compiler dependencies files are detected: :timestamp or :checksum
+    :change_detection => :timestamp,
+    # Sources combined into each generated jumbo translation unit (0 or 1 disables jumbo builds)
+    :jumbo_size => 0,
+    # Sources never combined into jumbo units (filenames or filepath glob patterns)
+    :jumbo_exclude => []
     },
 
   :test_build => {
@@ -293,6 +300,17 @@ DEFAULT_CEEDLING_PROJECT_CONFIG = {
     # Primarily useful for testing the fallback path and for toolchains that report
     # false support for -fdirectives-only. Default: false (use preprocessor when available).
     :preprocess_force_fallback => false,
+    # On-disk format of test results (.pass / .fail) files: :json (fast) or :yaml (export / legacy tooling)
+    :results_format => :json,
+    # Maximum lines of test executable output (e.g. `printf()`) kept in each test's results
+    :results_stdout_limit => 10000,
+    # Production sources of a test combined into each generated jumbo translation unit (0 or 1 disables)
+    :jumbo_size => 0,
+    # Production sources never combined into jumbo units (filenames or filepath glob patterns)
+    :jumbo_exclude => [],
+    # Compile each test with only the search paths its previous build needed
+    # (a failed compilation is retried with all search paths)
+    :minimal_search_paths => false,
   },
 
   :partials => {
@@ -0,0 +1,163 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'digest'
+
+##
+## In-memory graph of build targets and the files they were built from.
+##
+## Compilers write a make-style dependencies file (`.d`) for each object listing
+## its source and every header it includes. All of these files are parsed in one
+## pass into a compact structure -- each path interned once and each target's
+## dependencies held as a list of path indices -- instead of a Rake file task per
+## dependency. Each file is stat'ed (and, if needed, hashed) at most once per load.
+##
+## A target is stale if it is missing, any file it depends on is missing, or:
+##  - `:timestamp`: any file it depends on is newer than it.
+##  - `:checksum`:  the contents of the files it depends on differ from those recorded
+##                  in its fingerprint file (`record()`) when it was last built.
+##
+class DependencyGraph
+
+  constructor :file_wrapper
+
+  # Make-style rules (`target: dependency dependency \`) with continuation lines,
+  # comments, escaped spaces, and Windows drive letters (`C:\...`) in paths.
+  # All dependencies of all rules in a file belong to the file's target.
+  def self.parse_paths(contents)
+    paths = []
+
+    contents.gsub( /\\\r?\n/, ' ' ).each_line do |line|
+      line = line.sub( /#.*$/, '' )
+
+      # Rule separator is a colon followed by whitespace (a drive letter colon never is)
+      separator = (line =~ /:(\s|\z)/)
+      next if separator.nil?
+
+      line[(separator + 1)..-1].split( /(?<!\\)\s+/ ).each do |path|
+        next if path.empty?
+        paths << path.gsub( '\\ ', ' ' )
+      end
+    end
+
+    return paths.uniq
+  end
+
+  def setup()
+    @paths   = []   # Interned paths by index
+    @index   = {}   # Path => index
+    @targets = {}   # Target path => dependency path indices
+    @mtimes  = {}   # Index => modification time (nil if missing)
+    @digests = {}   # Index => contents digest (nil if missing)
+    @lock = Mutex.new
+  end
+
+
+  # `dependencies` maps target filepaths to their dependencies filepaths.
+  # Targets without a dependencies file (not yet built or built by tools that write
+  # none) are not tracked. Any previous file system observations are forgotten.
+  def load(dependencies)
+    @lock.synchronize do
+      @targets.clear()
+      @mtimes.clear()
+      @digests.clear()
+
+      dependencies.each do |target, filepath|
+        next if !@file_wrapper.exist?( filepath )
+        @targets[target] = parse( @file_wrapper.read( filepath ) )
+      end
+    end
+  end
+
+
+  def tracked?(target)
+    return @targets.key?( target )
+  end
+
+
+  # Tracked targets only
+  def stale?(target, detection:, fingerprint:nil)
+    @lock.synchronize do
+      dependencies = @targets[target]
+
+      return true if !@file_wrapper.exist?( target )
+      return true if dependencies.any? {|index| mtime( index ).nil?}
+
+      case detection
+      when :timestamp
+        built = File.mtime( target )
+        return dependencies.any? {|index| mtime( index ) > built}
+
+      when :checksum
+        return true if fingerprint.nil? || !@file_wrapper.exist?( fingerprint )
+        return @file_wrapper.read( fingerprint ) != digest( dependencies )
+      end
+    end
+  end
+
+
+  # Following a build of `target`, re-read its dependencies file and write a
+  # fingerprint of the contents of everything it was built from
+  def record(target, dependencies_filepath, fingerprint)
+    @lock.synchronize do
+      if !@file_wrapper.exist?( dependencies_filepath )
+        @targets.delete( target )
+        return
+      end
+
+      dependencies = parse( @file_wrapper.read( dependencies_filepath ) )
+      @targets[target] = dependencies
+
+      # Files a build just now read (e.g. a newly included header) may not yet be known
+      dependencies.each do |index|
+        @mtimes.delete( index )
+        @digests.delete( index )
+      end
+
+      return if dependencies.any? {|index| mtime( index ).nil?}
+      @file_wrapper.write( fingerprint, digest( dependencies ) )
+    end
+  end
+
+  ### Private ###
+
+  private
+
+  def parse(contents)
+    return DependencyGraph.parse_paths( contents ).map {|path| intern( path )}.uniq
+  end
+
+
+  def intern(path)
+    index = @index[path]
+    return index if !index.nil?
+
+    @paths << path.freeze
+    return (@index[path] = @paths.size - 1)
+  end
+
+
+  def mtime(index)
+    return @mtimes[index] if @mtimes.key?( index )
+
+    path = @paths[index]
+    return (@mtimes[index] = File.exist?( path ) ? File.mtime( path ) : nil)
+  end
+
+
+  def digest(dependencies)
+    digest = Digest::SHA256.new
+
+    dependencies.each do |index|
+      @digests[index] ||= Digest::SHA256.file( @paths[index] ).hexdigest
+      digest << @paths[index] << "\0" << @digests[index] << "\n"
+    end
+
+    return digest.hexdigest
+  end
+
+end
@@ -0,0 +1,292 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'json'
+require 'digest'
+require 'ceedling/constants'
+
+##
+## Test build explanations (`--explain`).
+##
+## For each artifact a test build generates it records why it was rebuilt:
+##  - :missing         -- no output from a previous build
+##  - :changed_input   -- an input is newer than the output, is missing, or was itself rebuilt
+##                        for a reason other than :forced
+##  - :changed_command -- the tool command line differs from the one recorded by the
+##                        previous build run with `--explain`
+##  - :forced          -- none of the above; the output was up to date (test builds always
+##                        regenerate their artifacts)
+##
+## Pipeline stages are grouped into the nodes of a test's dependency chain
+## (context → partials → mocks → runner → objects → link → run). From the duration of each
+## batch item in each node it finds the critical path -- the slowest item of each node, of
+## whichever test, as each stage waits on all of its items -- and the item that finished last
+## in each stage.
+##
+class Explainer
+
+  # Test dependency chain in build order
+  CHAIN = [:context, :partials, :mocks, :runner, :objects, :link, :run]
+
+  REASONS = {
+    :missing         => 'Missing',
+    :changed_input   => 'Changed input',
+    :changed_command => 'Changed command',
+    :forced          => 'Forced'
+  }
+
+  constructor :loginator, :file_wrapper
+
+  def setup()
+    @enabled = false
+    @path = nil
+    @stage = nil
+    @stages = []
+    @artifacts = {}     # Output filepath => artifact record
+    @commands = {}      # Output filepath => command line digest (previous builds)
+    @lock = Mutex.new
+  end
+
+
+  # `path` is the directory explanations (and recorded command lines) are written to
+  def enable(path)
+    @enabled = true
+    @path = path
+
+    filepath = File.join( @path, EXPLAIN_COMMANDS_FILENAME )
+    @commands = JSON.parse( @file_wrapper.read( filepath ) ) if @file_wrapper.exist?( filepath )
+  rescue JSON::ParserError
+    @commands = {}
+  end
+
+  def enabled?
+    return @enabled
+  end
+
+
+  # Time a pipeline stage belonging to dependency chain `node` (one of CHAIN) of build `context`
+  def stage(name, node:, context:)
+    return yield if !@enabled or node.nil?
+
+    @stage = {:name => name, :node => node, :context => context, :items => []}
+    started = clock()
+
+    begin
+      return yield
+    ensure
+      @stage[:wall] = clock() - started
+      @lock.synchronize { @stages << @stage }
+      @stage = nil
+    end
+  end
+
+
+  # Time a batch item of the current stage (if any) for `test`, working on `file` (if any)
+  def item(test:, file: nil)
+    stage = @stage
+    return yield if !@enabled or stage.nil? or test.nil?
+
+    started = clock()
+
+    begin
+      return yield
+    ensure
+      finished = clock()
+      record = {:test => test, :file => file&.to_s, :duration => (finished - started), :finished => finished}
+      @lock.synchronize { stage[:items] << record }
+    end
+  end
+
+
+  # Generate an artifact of chain node `node` in the block. `outputs` are the files the block
+  # writes (the first is reported). `inputs` are the files they were generated from.
+  def artifact(node, test:, outputs:, inputs: [])
+    return yield if !@enabled
+
+    outputs = outputs.flatten.compact
+    reason, cause = examine( outputs, inputs )
+
+    record = {
+      :node     => node,
+      :context  => @stage&.[]( :context ),
+      :test     => test,
+      :output   => outputs.first,
+      :reason   => reason,
+      :cause    => cause,
+      :commands => []
+    }
+
+    Thread.current[:ceedling_explain_artifact] = record
+    begin
+      result = yield
+    ensure
+      Thread.current[:ceedling_explain_artifact] = nil
+    end
+
+    digest = record[:commands].empty? ? nil : Digest::SHA256.hexdigest( record[:commands].join( "\n" ) )
+    previous = @commands[record[:output]]
+
+    if (reason == :forced) and !digest.nil? and !previous.nil? and (previous != digest)
+      record[:reason] = :changed_command
+    end
+
+    @lock.synchronize do
+      # Absolute paths -- dependencies files may name the same file differently
+      outputs.each {|output| @artifacts[File.expand_path( output )] = record}
+      @commands[record[:output]] = digest if !digest.nil?
+    end
+
+    @loginator.event( :rebuild, {:artifact => record[:output], :reason => record[:reason], :cause => record[:cause]}.compact )
+
+    return result
+  end
+
+
+  # Tool command line executed on behalf of the current thread's artifact (if any)
+  def command(line)
+    return if !@enabled
+
+    record = Thread.current[:ceedling_explain_artifact]
+    record[:commands] << line if !record.nil?
+  end
+
+
+  # Write explanations and log the summary
+  def report()
+    return if !@enabled
+
+    stages, artifacts, commands = @lock.synchronize { [@stages.dup, @artifacts.values.uniq, @commands.dup] }
+
+    summary = stages.map {|stage| stage[:context]}.uniq.map do |context|
+      summarize(
+        context,
+        stages.select {|stage| stage[:context] == context},
+        artifacts.select {|artifact| artifact[:context] == context}
+      )
+    end
+
+    @file_wrapper.mkdir( @path )
+    @file_wrapper.write( File.join( @path, EXPLAIN_REPORT_FILENAME ), (summary + [listing( artifacts )]).join( "\n" ) )
+    @file_wrapper.write( File.join( @path, EXPLAIN_COMMANDS_FILENAME ), JSON.generate( commands ) )
+
+    @loginator.log( "\n" + summary.join( "\n" ), Verbosity::NORMAL, LogLabels::NONE )
+    @loginator.log( "Explanations written to #{File.join( @path, EXPLAIN_REPORT_FILENAME )}\n", Verbosity::NORMAL, LogLabels::NONE )
+  end
+
+  ### Private ###
+
+  private
+
+  def clock()
+    return Process.clock_gettime( Process::CLOCK_MONOTONIC )
+  end
+
+  # [reason, cause] of (re)generating `outputs` from `inputs`
+  def examine(outputs, inputs)
+    missing = outputs.find {|output| !@file_wrapper.exist?( output )}
+    return [:missing, nil] if !missing.nil?
+
+    inputs.compact.each do |input|
+      upstream = @lock.synchronize { @artifacts[File.expand_path( input )] }
+
+      # Regenerated earlier in this build -- changed only if it changed for a reason of its own
+      if !upstream.nil?
+        next if upstream[:reason] == :forced
+        return [:changed_input, input]
+      end
+
+      return [:changed_input, input] if !@file_wrapper.exist?( input )
+      return [:changed_input, input] if outputs.any? {|output| @file_wrapper.newer?( input, output )}
+    end
+
+    return [:forced, nil]
+  end
+
+  # Rebuild reasons, the critical path through the dependency chain, and the last item to finish in each stage
+  def summarize(context, stages, artifacts)
+    lines = []
+    wall = stages.sum {|stage| stage[:wall]}
+
+    # Node => [duration, test, file] of its slowest item of any test (durations of one test's file
+    # summed over a node's stages). No node of any test can begin before the slowest item of the
+    # node before it finishes, so together these are the critical path.
+    path = {}
+    CHAIN.each do |node|
+      totals = Hash.new( 0.0 )
+      stages.select {|stage| stage[:node] == node}.each do |stage|
+        stage[:items].each {|item| totals[[item[:test], item[:file]]] += item[:duration]}
+      end
+
+      (test, file), duration = totals.max_by {|_, duration| duration}
+      path[node] = [duration, test, file] if !duration.nil?
+    end
+
+    lines << "EXPLAIN: #{context} build"
+    lines << ''
+    lines << rebuilds( artifacts )
+
+    if !path.empty?
+      length = path.values.sum {|duration, _, _| duration}
+      lines << "Critical path: #{seconds( length )} of #{seconds( wall )} spent in the slowest item of each node"
+      path.each do |node, (duration, test, file)|
+        lines << format( '  %-10s %10s  %s', node, seconds( duration ), [test, file].compact.join( ' | ' ) )
+      end
+      lines << ''
+    end
+
+    lines << 'Last item to finish in each stage'
+    lines << format( '  %-46s %10s %10s  %s', 'Stage', 'Wall', 'Item', 'Test / File' )
+    stages.each do |stage|
+      last = stage[:items].max_by {|item| item[:finished]}
+      next if last.nil?
+
+      lines << format( '  %-46s %10s %10s  %s',
+        stage[:name][0, 46],
+        seconds( stage[:wall] ),
+        seconds( last[:duration] ),
+        [last[:test], last[:file]].compact.join( ' | ' )
+      )
+    end
+    lines << ''
+
+    return lines.join( "\n" )
+  end
+
+  def rebuilds(artifacts)
+    lines = []
+
+    lines << "Rebuilt artifacts (#{artifacts.size})"
+    lines << format( '  %-10s %10s %14s %16s %10s', 'Node', *REASONS.values )
+    CHAIN.each do |node|
+      selected = artifacts.select {|artifact| artifact[:node] == node}
+      next if selected.empty?
+
+      counts = REASONS.keys.map {|reason| selected.count {|artifact| artifact[:reason] == reason}}
+      lines << format( '  %-10s %10d %14d %16d %10d', node, *counts )
+    end
+    lines << '  (Forced: up to date but regenerated -- test builds do not skip up-to-date artifacts)'
+    lines << ''
+
+    return lines.join( "\n" )
+  end
+
+  def listing(artifacts)
+    lines = ['Artifacts']
+
+    artifacts.sort_by {|artifact| [REASONS.keys.index( artifact[:reason] ), CHAIN.index( artifact[:node] ).to_i, artifact[:output]]}.each do |artifact|
+      cause = artifact[:cause].nil? ? '' : " (#{artifact[:cause]})"
+      lines << format( '  %-16s %-8s %s%s', REASONS[artifact[:reason]], artifact[:node], artifact[:output], cause )
+    end
+
+    return lines.join( "\n" ) + "\n"
+  end
+
+  def seconds(value)
+    return format( '%.3fs', value )
+  end
+
+end
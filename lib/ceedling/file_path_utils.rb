@@ -156,6 +156,10 @@ class FilePathUtils
     return File.join( @configurator.project_release_build_output_path, File.basename(filepath).ext(@configurator.extension_list) )
   end
 
+  def form_release_fingerprint_filepath(filepath)
+    return File.join( @configurator.project_release_dependencies_path, File.basename(filepath).ext(EXTENSION_FINGERPRINT) )
+  end
+
   def form_release_dependencies_filelist(files)
     return (@file_wrapper.instantiate_file_list(files)).pathmap("#{@configurator.project_release_dependencies_path}/%n#{@configurator.extension_dependencies}")
   end
@@ -198,6 +202,11 @@ class FilePathUtils
     )
   end
 
+  # Produces: <build_root>/<context>/cache/<test>/search_paths.yml
+  def form_test_search_paths_cache_filepath(name, context: nil)
+    File.join( form_build_context_path(BUILD_CACHE_DIR, name: name, context: context), SEARCH_PATHS_CACHE_FILENAME )
+  end
+
   def form_test_mocks_path(name, context: nil)
     form_named_path(@configurator.cmock_mock_path, name)
   end
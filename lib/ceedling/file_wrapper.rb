@@ -95,10 +95,9 @@ class FileWrapper
     return (File.mtime(filepathA) > File.mtime(filepathB))
   end
 
-  def open(filepath, flags)
-    File.open(filepath, flags) do |file|
-      yield(file)
-    end
+  # Without a block, returns the open file (caller closes it)
+  def open(filepath, flags, &block)
+    return File.open(filepath, flags, &block)
   end
 
   def read(filepath, length=nil)
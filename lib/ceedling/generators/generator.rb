@@ -236,7 +236,9 @@ class Generator
         arg_hash[:list],
         arg_hash[:dependencies],
         arg_hash[:search_paths],
-        arg_hash[:defines]
+        arg_hash[:defines],
+        # Search paths & defines shared by a test's (or release build's) compilations
+        response_file: response_file( context, [5, 6] )
       )
 
     begin
@@ -301,7 +303,8 @@ class Generator
         arg_hash[:search_paths],
         arg_hash[:defines],
         arg_hash[:list],
-        arg_hash[:dependencies]
+        arg_hash[:dependencies],
+        response_file: response_file( context, [3, 4] )
       )
 
     begin
@@ -343,7 +346,9 @@ class Generator
         arg_hash[:executable],
         arg_hash[:map],
         arg_hash[:libraries],
-        arg_hash[:libpaths]
+        arg_hash[:libpaths],
+        # Object file lists can be long enough to exceed command line length limits
+        response_file: response_file( context, [1] )
       )
 
     begin
@@ -389,7 +394,23 @@ class Generator
     # We allow it to fail without an exception.
     # We'll analyze its results apart from tool_executor
     command[:options][:boom] = false
-    shell_result = @tool_executor.exec( command )
+    command[:options][:output_limit] = TEST_OUTPUT_CAPTURE_LIMIT
+
+    test_file = @file_finder.find_test_file_from_filepath( arg_hash[:executable] )
+
+    # Parse results as the test executable runs, notifying plugins of each test case result
+    parser = @generator_test_results.create_parser( executable: executable, test_file: test_file ) do |status, test_case|
+      @plugin_manager.post_test_case_execute(
+        arg_hash.slice( :context, :test_name, :test_filepath, :executable ).merge( :status => status, :test_case => test_case )
+      )
+    end
+
+    shell_result = @tool_executor.exec( command ) do |stream, chunk|
+      # Unity writes results to $stdout; $stderr is appended after, matching the combined output
+      parser << chunk if stream == :stdout
+    end
+    parser << shell_result[:stderr]
+
     filename = File.basename( test_filepath )
 
     # Handle crashes
@@ -400,6 +421,9 @@ class Generator
         @configurator.project_config_hash[:project_use_backtrace]
       )
 
+      # Crash handling regenerates output for results processing
+      parser = nil
+
       # Lookup test cases and filter based on any matchers specified for the build task
       test_cases = @test_context_extractor.lookup_test_cases( test_filepath )
       test_cases = @generator_test_results.filter_test_cases( test_cases )
@@ -415,6 +439,11 @@ class Generator
         shell_result =
           @backtrace.do_simple( filename, executable, shell_result, test_cases, context: context )
 
+      # Simple exercise narrowed down by halves
+      when :bisect
+        shell_result =
+          @backtrace.do_simple( filename, executable, shell_result, test_cases, context: context, bisect: true )
+
       else # :none
         # Otherwise, call a crash a single failure so it shows up in the report
         shell_result = @generator_test_results.create_crash_failure(
@@ -427,8 +456,8 @@ class Generator
     
     shell_result[:executable] = executable
     shell_result[:result_file] = arg_hash[:result_file]
-    shell_result[:test_file] = @file_finder.find_test_file_from_filepath( arg_hash[:executable] )
-    processed = @generator_test_results.process_and_write_results( shell_result )
+    shell_result[:test_file] = test_file
+    processed = @generator_test_results.process_and_write_results( shell_result, parser )
 
     arg_hash[:result_file]  = processed[:result_file]
     arg_hash[:results]      = processed[:results]
@@ -440,4 +469,17 @@ class Generator
     shell_result
   end
 
+  ### Private ###
+
+  private
+
+  # Response file option for `ToolExecutor.build_command_line()` moving the given
+  # argument replacements into a GCC-style `@file` (if enabled)
+  def response_file(context, replacements)
+    return nil if !@configurator.project_use_response_files
+
+    path = (context == RELEASE_SYM) ? @configurator.project_release_response_files_path : @configurator.project_test_response_files_path
+    return { :path => path, :replacements => replacements }
+  end
+
 end
@@ -91,7 +91,7 @@ class GeneratorHelper
 
     # Incorporate knowledge of the backtrace setting into a recommendation
     case backtrace
-    when :simple
+    when :simple, :bisect
       notice += "> Consider configuring :project ↳ :use_backtrace to use the :gdb option to find the cause (see documentation).\n"
     when :none
       notice += "> Consider configuring :project ↳ :use_backtrace to help find the cause (see documentation).\n"
@@ -9,6 +9,7 @@ require 'rubygems'
 require 'rake' # for .ext()
 require 'ceedling/constants'
 require 'ceedling/exceptions'
+require 'ceedling/generators/unity_output_parser'
 
 
 ##
@@ -18,7 +19,7 @@ require 'ceedling/exceptions'
 ## - Output is line-oriented. Anything outside the recognized lines is assumed to be from `printf()`
 ##   or equivalent calls and collected for presentation as a collection of $stdout lines.
 ## - Multiline output (i.e. failure messages) can be achieved by "encoding" newlines as literal 
-##   "\n"s (slash-n). `extract_line_elements()` handles converting newline markers into real newlines.
+##   "\n"s (slash-n). UnityOutputParser handles converting newline markers into real newlines.
 ## - :PASS has no trailing message unless Unity's test case execution duration feature is enabled.
 ##   If enabled, a numeric value with 'ms' as a units signifier trails, ":PASS 1.2 ms".
 ## - :IGNORE optionally can include a trailing message.
@@ -42,6 +43,7 @@ require 'ceedling/exceptions'
 ##
 ## Sample Test Results Output File (YAML)
 ## ======================================
+## (Shown in optional YAML export format; default JSON format holds the same structure.)
 ## The following corresponds to the test executable output above.
 ##
 ## TestUsartModel.fail:
@@ -87,78 +89,44 @@ require 'ceedling/exceptions'
 
 class GeneratorTestResults
 
-  constructor :configurator, :generator_test_results_sanity_checker, :loginator, :reportinator, :yaml_wrapper
+  constructor :configurator, :generator_test_results_sanity_checker, :loginator, :reportinator, :test_results_store
 
   def setup()
     # Aliases
     @sanity_checker = @generator_test_results_sanity_checker
   end
 
-  def process_and_write_results(unity_shell_result)
+  # Create a parser to be fed test executable output as it runs (see UnityOutputParser)
+  def create_parser(executable:, test_file:, &on_test_case)
+    return UnityOutputParser.new(
+      executable:   executable,
+      test_file:    test_file,
+      stdout_limit: @configurator.test_build_results_stdout_limit,
+      &on_test_case
+    )
+  end
+
+  # If no parser is provided (or the parser has already been fed the executable's output
+  # as it ran), the complete output in the shell result is parsed in one go.
+  def process_and_write_results(unity_shell_result, parser=nil)
 
     executable  = unity_shell_result[:executable]
     output_file = unity_shell_result[:result_file]
     test_file   = unity_shell_result[:test_file]
 
-    results = get_results_structure
-
-    results[:source][:dirname] = File.dirname(test_file)
-    results[:source][:basename] = File.basename(test_file)
-    results[:source][:file] = test_file
-    results[:time] = unity_shell_result[:time] unless unity_shell_result[:time].nil?
+    if parser.nil?
+      parser = create_parser( executable: executable, test_file: test_file )
+      parser << unity_shell_result[:output]
+    end
 
-    # When Unity is built with UNITY_OUTPUT_COLOR, ANSI escape sequences wrap
-    # test-result tokens and the summary result token, e.g.:
-    #   test_foo.c:24:test_bar:\e[0;32mPASS\e[0m
-    #   test_foo.c:39:test_baz:\e[0;31mFAIL\e[0m: Expected 2 Was 3
-    #   ---------\n2 Tests 0 Failures 0 Ignored\n\e[0;32mOK\e[0m
-    # Strip them up front so that all downstream regex anchors and literal
-    # tokens (including TEST_STDOUT_STATISTICS) work correctly.
-    raw_output = unity_shell_result[:output].gsub(/\e\[[\d;]*[mK]/, '')
+    results = parser.finish()
 
     # Process test statistics
-    if (raw_output =~ PATTERNS::TEST_STDOUT_STATISTICS)
-      results[:counts][:total] =   $1.to_i
-      results[:counts][:failed] =  $2.to_i
-      results[:counts][:ignored] = $3.to_i
-      results[:counts][:passed] = (results[:counts][:total] - results[:counts][:failed] - results[:counts][:ignored])
-    else
+    if !parser.statistics?
       raise CeedlingException.new( "Could not parse output for `#{executable}` ⏩️ \"#{unity_shell_result[:output]}\"" )
     end
 
-    # Remove test statistics lines
-    output_string = raw_output.sub( PATTERNS::TEST_STDOUT_STATISTICS, '' )
-
-    # Process test executable results line-by-line
-    output_string.lines do |line|
-      # Process Unity test executable output
-      chomped_line = line.chomp
-      case chomped_line
-      when /(:IGNORE)/
-        elements = extract_line_elements( executable, line, results[:source][:file] )
-        results[:ignores] << elements[0] 
-        results[:stdout] << elements[1] unless (elements[1].nil? || elements[1].empty?)
-
-      when /(:PASS$)/
-        elements = extract_line_elements( executable, line, results[:source][:file] )
-        results[:successes] << elements[0] 
-        results[:stdout] << elements[1] unless (elements[1].nil? || elements[1].empty?)
-
-      when /(:PASS \(.* ms\)$)/
-        elements = extract_line_elements( executable, line, results[:source][:file] )
-        results[:successes] << elements[0] 
-        results[:stdout] << elements[1] unless (elements[1].nil? || elements[1].empty?)
-
-      when /(:FAIL)/
-        elements = extract_line_elements( executable, line, results[:source][:file] )
-        results[:failures] << elements[0]
-        results[:stdout] << elements[1] unless (elements[1].nil? || elements[1].empty?)
-
-      # Collect up all other output
-      else
-        results[:stdout] << chomped_line unless chomped_line.empty?
-      end
-    end
+    results[:time] = unity_shell_result[:time] unless unity_shell_result[:time].nil?
 
     @loginator.log("Test results from #{File.basename(executable)} => #{results}", Verbosity::DEBUG)
 
@@ -169,7 +137,7 @@ class GeneratorTestResults
     msg = @reportinator.generate_progress("Collecting test results from #{File.basename(executable)} to #{output_file}")
     @loginator.log(msg, Verbosity::OBNOXIOUS)
 
-    @yaml_wrapper.dump(output_file, results)
+    @test_results_store.write(output_file, results)
 
     return { :result_file => output_file, :results => results }
   end
@@ -237,60 +205,4 @@ class GeneratorTestResults
     return UNITY_TEST_RESULTS_TEMPLATE % values
   end
 
-  ### Private ### 
-  
-  private
-
-  def get_results_structure
-    return {
-      :source    => {:file => '', :dirname => '', :basename => '' },
-      :successes => [],
-      :failures  => [],
-      :ignores   => [],
-      :counts    => {:total => 0, :passed => 0, :failed => 0, :ignored  => 0},
-      :stdout    => [],
-      :time      => 0.0
-      }
-  end
-
-  def extract_line_elements(executable, line, filename)
-    # Handle anything preceding filename in line as extra output to be collected
-    stdout = nil
-    stdout_regex = /(.+)#{Regexp.escape(filename)}:[0-9]+:(PASS|IGNORE|FAIL).+/i
-    unity_test_time = 0 
-
-    if (line =~ stdout_regex)
-      stdout = $1.clone
-      line.sub!(/#{Regexp.escape(stdout)}/, '')
-    end
-
-    # Collect up test results minus any extra output
-    elements = (line.strip.split(':'))[1..-1]
-
-    # Find timestamp if available
-    if (elements[-1] =~ / \((\d*(?:\.\d*)?) ms\)/)
-      unity_test_time = $1.to_f / 1000
-      elements[-1].sub!(/ \((\d*(?:\.\d*)?) ms\)/, '')
-    end
-
-    if elements[3..-1]
-      message = (elements[3..-1].join(':')).strip
-    else
-      message = nil
-    end
-
-    components = {
-      :test => elements[1],
-      :line => elements[0].to_i,
-      # Decode any multline strings
-      :message => message.nil? ? nil : message.gsub( NEWLINE_TOKEN, "\n" ),
-      :unity_test_time => unity_test_time
-    }
-
-    return components, stdout if elements.size >= 3
-    
-    # Fall through failure case
-    raise CeedlingException.new( "Could not parse results output line \"line\" for `#{executable}`" )
-  end
-
 end
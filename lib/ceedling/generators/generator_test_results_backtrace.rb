@@ -5,6 +5,8 @@
 #   SPDX-License-Identifier: MIT
 # =========================================================================
 
+require 'parallel'
+
 class GeneratorTestResultsBacktrace
 
   constructor :configurator, :tool_executor, :generator_test_results, :generator_helper,
@@ -14,24 +16,33 @@ class GeneratorTestResultsBacktrace
     @RESULTS_COLLECTOR = Struct.new( :passed, :failed, :ignored, :output, keyword_init:true )
     # Alias, matching Generator's own convention for the same dependency.
     @helper = @generator_helper
+
+    # Diagnostic runs of every crashed test share one budget of concurrent runs (see `with_run_slot`)
+    @run_slots = nil
+    @run_slots_lock = Mutex.new
   end
 
   # Re-runs each test case (or, for a parameterized test, each group of parameterized
   # cases -- see `group_test_cases`) under gdb to identify which one(s) crashed and why.
+  # All groups run in turn within a single gdb session (see `run_gdb_session`) so that
+  # gdb's startup and symbol loading are paid once per executable rather than per group.
   # Writes the full gdb transcript to a per-test-case log file and assembles a
   # terse crash label (signal + description, optional source line in backticks)
   # for each failing test case. Returns a modified shell_result with regenerated output.
   def do_gdb(filename, executable, shell_result, test_cases, context:)
-    gdb_script_filepath = File.join( @configurator.project_build_tests_root, BACKTRACE_GDB_SCRIPT_FILE )
-
     # Clean stats tracker
     test_case_results = @RESULTS_COLLECTOR.new( passed:0, failed:0, ignored:0, output:[] )
 
-    # Reset time
-    shell_result[:time] = 0
-
     test_name = File.basename( filename, '.*' )
 
+    groups = group_test_cases( test_cases )
+
+    # Per-group gdb transcripts plus summed execution time of the gdb session(s)
+    # Note: Running tests separately increases total execution time
+    crash_results, time = run_gdb_session( executable, groups )
+
+    shell_result[:time] = time
+
     # True once some retry group has actually shown crash evidence of its own -- an
     # unresolved member, or (below) a group whose real status contradicts a fully clean
     # set of matches. If this stays false across every group, the whole diagnostic never
@@ -39,24 +50,8 @@ class GeneratorTestResultsBacktrace
     # can be trusted -- see the fallback after the loop.
     any_group_crashed = false
 
-    # Iterate on test cases, one sub-process run per group (see `group_test_cases`)
-    group_test_cases( test_cases ).each do |group|
-      # Build the test fixture to run with our test case (or parameterized group) of interest
-      command = @tool_executor.build_command_line(
-        @configurator.tools_test_backtrace_gdb, [],
-        gdb_script_filepath,
-        executable,
-        unity_filter_arg( group )
-      )
-      # Things are gonna go boom, so ignore booms to get output
-      command[:options][:boom] = false
-
-      crash_result = @tool_executor.exec( command )
-
-      # Sum execution time for each sub-process run
-      # Note: Running tests separately increases total execution time
-      shell_result[:time] += crash_result[:time].to_f()
-
+    # Iterate on test cases, one run within the gdb session per group (see `group_test_cases`)
+    groups.zip( crash_results ).each do |group, crash_result|
       # Buffered separately from test_case_results and only merged in afterward, since
       # the status check below can still discard every match here in favor of a crash
       # attribution, once the whole group has been seen.
@@ -217,99 +212,33 @@ class GeneratorTestResultsBacktrace
 
   # Re-runs each test case (or, for a parameterized test, each group of parameterized
   # cases -- see `group_test_cases`) individually to determine which one(s) crashed.
+  # Diagnostic runs are dispatched in parallel, up to :project ↳ :test_threads at once across
+  # all crashed tests (see `with_run_slot`).
+  # With `bisect`, groups are instead run together in ever smaller halves so that a
+  # crashing group is found in O(log n) runs (see `bisect_simple_groups`).
   # For crash cases, captures any extra output from the test binary (e.g.
   # assertion messages on stderr) and includes it in the failure report.
   # Returns a modified shell_result with regenerated output.
-  def do_simple(filename, executable, shell_result, test_cases, context:)
+  def do_simple(filename, executable, shell_result, test_cases, context:, bisect: false)
     # Clean stats tracker
     test_case_results = @RESULTS_COLLECTOR.new( passed:0, failed:0, ignored:0, output:[] )
 
-    # Reset time
-    shell_result[:time] = 0
-
-    # True once some retry group has actually shown crash evidence of its own -- a
-    # member with no result line, or (below) a group whose real status contradicts a
-    # fully clean set of matches. If this stays false across every group, the whole
-    # diagnostic never reproduced or attributed the crash the main run already
-    # detected, and none of it can be trusted -- see the fallback after the loop.
-    any_group_crashed = false
-
-    # Iterate on test cases, one sub-process run per group (see `group_test_cases`)
-    group_test_cases( test_cases ).each do |group|
-      # Build the test fixture to run with our test case (or parameterized group) of interest
-      command = @tool_executor.build_command_line(
-        @configurator.tools_test_fixture_simple_backtrace, [],
-        executable,
-        unity_filter_arg( group )
-      )
-      # Things are gonna go boom, so ignore booms to get output
-      command[:options][:boom] = false
+    groups = group_test_cases( test_cases )
 
-      crash_result = @tool_executor.exec( command )
+    # Per-group [results, crashed] in group order plus summed execution time of every sub-process run
+    # Note: Running tests separately increases total execution time
+    outcomes, time = bisect ? bisect_simple_groups( filename, executable, groups ) : run_simple_groups( filename, executable, groups )
 
-      # Sum execution time for each sub-process run
-      # Note: Running tests separately increases total execution time
-      shell_result[:time] += crash_result[:time].to_f()
+    shell_result[:time] = time
 
-      # Buffered separately from test_case_results and only merged in afterward, since
-      # the status check below can still discard every match here in favor of a crash
-      # attribution, once the whole group has been seen.
-      group_results = @RESULTS_COLLECTOR.new( passed:0, failed:0, ignored:0, output:[] )
-      crashed = false # Has the actual crash in this group already been attributed?
-
-      # Attribute each group member its own real result line, if Unity printed one
-      group.each do |test_case|
-        case crash_result[:output]
-        # Success test case
-        when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:PASS\s*$)/
-          group_results[:passed]  += 1
-          group_results[:output] << $1
-
-        # Ignored test case
-        when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:IGNORE\s*$)/
-          group_results[:ignored] += 1
-          group_results[:output] << $1
-
-        when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:FAIL(:.+)?\s*$)/
-          group_results[:failed]  += 1
-          group_results[:output] << $1
-
-        # No result line for this member -- either it crashed, or it never got to run
-        # because an earlier member in this same group crashed.
-        else
-          group_results[:failed] += 1
-
-          if crashed
-            group_results[:output] <<
-              "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: " \
-              "Test case not run -- an earlier case in this parameterized test group crashed"
-          else
-            crashed = true
-            # Collect any non-result, non-blank lines (e.g. assertion messages on stderr)
-            extra = extract_simple_crash_output( crash_result[:output], filename )
-            test_output = "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: Test case crashed"
-            test_output += " >> #{extra.join(NEWLINE_TOKEN)}" unless extra.empty?
-            group_results[:output] << test_output
-          end
-        end
-      end
-
-      # Every member in this group resolved via a matched result line -- but a diagnostic
-      # retry running through its own, separately-configured tool (e.g. without the main
-      # :test_fixture's sanitizer options) can complete cleanly and print a legitimate-
-      # looking PASS even when it isn't a trustworthy stand-in for what actually happened.
-      # The same real-status check the main run itself relies on applies here too.
-      if !crashed && @helper.test_crash?( filename, executable, crash_result )
-        crashed = true
-        group_results = @RESULTS_COLLECTOR.new(
-          passed: 0, ignored: 0, failed: group.size,
-          output: group.map { |test_case|
-            "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: Test case crashed" \
-            " >> diagnostic retry's own exit status contradicts its reported clean result"
-          }
-        )
-      end
+    # True once some retry group has actually shown crash evidence of its own -- a
+    # member with no result line, or a group whose real status contradicts a fully
+    # clean set of matches (see `simple_group_results`). If this stays false across
+    # every group, the whole diagnostic never reproduced or attributed the crash the
+    # main run already detected, and none of it can be trusted -- see the fallback below.
+    any_group_crashed = false
 
+    outcomes.each do |group_results, crashed|
       any_group_crashed ||= crashed
 
       test_case_results[:passed]  += group_results[:passed]
@@ -348,6 +277,231 @@ class GeneratorTestResultsBacktrace
   ### Private ###
   private
 
+  # One sub-process run per group, run in parallel within the shared budget of runs
+  def run_simple_groups(filename, executable, groups)
+    runs = Parallel.map( groups, in_threads: @configurator.project_test_threads ) do |group|
+      crash_result = with_run_slot { run_simple( executable, [group] ) }
+      [simple_group_results( filename, executable, group, crash_result ), crash_result[:time].to_f()]
+    end
+
+    return runs.map {|outcome, _| outcome }, runs.sum {|_, time| time }
+  end
+
+  # Runs groups together, narrowing by halves only where a run crashes:
+  #  - A run that completes cleanly attributes every group in it its real result.
+  #  - A crashing run of a single group attributes the crash to that group.
+  #  - A crashing run of several groups is split in two, and each half is run (concurrently).
+  # A single crashing group among n is found in O(log n) runs.
+  # Only non-parameterized groups can be selected exactly together (see `unity_filter_arg`);
+  # each parameterized group is run on its own.
+  def bisect_simple_groups(filename, executable, groups)
+    outcomes = Array.new( groups.size )
+    time = 0.0
+    lock = Mutex.new
+
+    isolate = lambda do |indices|
+      crash_result = with_run_slot { run_simple( executable, indices.map {|index| groups[index] } ) }
+      lock.synchronize { time += crash_result[:time].to_f() }
+
+      if (indices.size == 1) or !@helper.test_crash?( filename, executable, crash_result )
+        indices.each do |index|
+          outcomes[index] = simple_group_results( filename, executable, groups[index], crash_result )
+        end
+      else
+        halves = indices.each_slice( (indices.size / 2.0).ceil ).to_a
+        Parallel.each( halves, in_threads: [@configurator.project_test_threads, 2].min ) {|half| isolate.call( half ) }
+      end
+    end
+
+    parameterized, plain = (0...groups.size).partition {|index| parameterized_group?( groups[index] ) }
+    runs = parameterized.map {|index| [index] }
+    runs.unshift( plain ) if !plain.empty?
+
+    Parallel.each( runs, in_threads: @configurator.project_test_threads ) {|indices| isolate.call( indices ) }
+
+    return outcomes, time
+  end
+
+  # Diagnostic runs happen within a test already running on the test worker pool. Bounding them
+  # by one budget of :test_threads runs across all tests keeps several crashed tests from each
+  # starting a full pool of runs of their own.
+  def with_run_slot()
+    slots = @run_slots_lock.synchronize do
+      @run_slots ||= Queue.new.tap {|queue| @configurator.project_test_threads.times { queue << true } }
+    end
+
+    slots.pop
+    begin
+      return yield
+    ensure
+      slots << true
+    end
+  end
+
+  # Runs every group in turn within one gdb session (see `gdb_session_script`) and
+  # splits the session transcript back into one result per group, each with the
+  # session's own status. Should a session end before all its groups have run (e.g.
+  # gdb aborting its script on an error in the crash handler), a new session resumes
+  # with the first group not yet started.
+  # Returns [per-group results, summed execution time of the session(s)].
+  def run_gdb_session(executable, groups)
+    handler_filepath = File.join( @configurator.project_build_tests_root, BACKTRACE_GDB_SCRIPT_FILE )
+    # Alongside the executable -- unique per test and build context
+    session_filepath = File.join( File.dirname( executable ), File.basename( executable, '.*' ) + BACKTRACE_GDB_SESSION_EXTENSION )
+
+    crash_results = Array.new( groups.size )
+    time = 0.0
+    start = 0
+
+    while start < groups.size
+      @file_wrapper.write( session_filepath, gdb_session_script( groups, start, handler_filepath ) )
+
+      command = @tool_executor.build_command_line(
+        @configurator.tools_test_backtrace_gdb, [],
+        session_filepath,
+        executable
+      )
+      # Things are gonna go boom, so ignore booms to get output
+      command[:options][:boom] = false
+
+      session_result = @tool_executor.exec( command )
+      time += session_result[:time].to_f()
+
+      transcripts = split_gdb_session( session_result[:output] )
+
+      # Not even the first run began (e.g. gdb could not load the executable) --
+      # another session would fare no better. Every remaining group gets the whole
+      # output, leaving crash attribution to report what it can.
+      if transcripts.empty?
+        (start...groups.size).each {|index| crash_results[index] = session_result }
+        break
+      end
+
+      transcripts.each do |index, transcript|
+        crash_results[index] = session_result.merge( output: transcript )
+      end
+
+      start = transcripts.keys.max + 1
+    end
+
+    return crash_results, time
+  end
+
+  # gdb command script running groups[start..] in turn. Each run is preceded by a
+  # marker line (see `split_gdb_session`) and followed by the crash handler script,
+  # which prints a backtrace and kills the process if it did not exit on its own.
+  def gdb_session_script(groups, start, handler_filepath)
+    script = []
+    script << 'set pagination off'
+    script << 'set confirm off'
+
+    (start...groups.size).each do |index|
+      script << %(echo \\n#{BACKTRACE_GDB_SESSION_MARKER} #{index}\\n)
+      # Clear the previous run's exit code (assigning a never-set, void variable) so
+      # the crash handler can tell whether this run exited
+      script << 'set $_exitcode = $_ceedling_unset'
+      script << "run #{unity_filter_arg( [groups[index]] )}"
+      script << %(source "#{handler_filepath}")
+    end
+
+    return script.join( "\n" ) + "\n"
+  end
+
+  # Splits a gdb session transcript at its run markers.
+  # Returns {group index => transcript of that group's run}.
+  def split_gdb_session(output)
+    transcripts = {}
+    index = nil
+
+    output.each_line do |line|
+      if (line =~ /^#{Regexp.escape( BACKTRACE_GDB_SESSION_MARKER )} (\d+)\s*$/)
+        index = $1.to_i
+        transcripts[index] = ''
+        next
+      end
+
+      # Anything before the first marker is gdb's own preamble
+      transcripts[index] << line if !index.nil?
+    end
+
+    return transcripts
+  end
+
+  # Run the test fixture with our test case group(s) of interest
+  def run_simple(executable, groups)
+    command = @tool_executor.build_command_line(
+      @configurator.tools_test_fixture_simple_backtrace, [],
+      executable,
+      unity_filter_arg( groups )
+    )
+    # Things are gonna go boom, so ignore booms to get output
+    command[:options][:boom] = false
+
+    return @tool_executor.exec( command )
+  end
+
+  # Attributes each member of a group its result from a diagnostic run's output.
+  # Returns [group results, whether the group showed crash evidence].
+  def simple_group_results(filename, executable, group, crash_result)
+    group_results = @RESULTS_COLLECTOR.new( passed:0, failed:0, ignored:0, output:[] )
+    crashed = false # Has the actual crash in this group already been attributed?
+
+    # Attribute each group member its own real result line, if Unity printed one
+    group.each do |test_case|
+      case crash_result[:output]
+      # Success test case
+      when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:PASS\s*$)/
+        group_results[:passed]  += 1
+        group_results[:output] << $1
+
+      # Ignored test case
+      when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:IGNORE\s*$)/
+        group_results[:ignored] += 1
+        group_results[:output] << $1
+
+      when /(^#{Regexp.escape(filename)}:\d+:#{Regexp.escape(test_case[:test])}:FAIL(:.+)?\s*$)/
+        group_results[:failed]  += 1
+        group_results[:output] << $1
+
+      # No result line for this member -- either it crashed, or it never got to run
+      # because an earlier member in this same group crashed.
+      else
+        group_results[:failed] += 1
+
+        if crashed
+          group_results[:output] <<
+            "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: " \
+            "Test case not run -- an earlier case in this parameterized test group crashed"
+        else
+          crashed = true
+          # Collect any non-result, non-blank lines (e.g. assertion messages on stderr)
+          extra = extract_simple_crash_output( crash_result[:output], filename )
+          test_output = "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: Test case crashed"
+          test_output += " >> #{extra.join(NEWLINE_TOKEN)}" unless extra.empty?
+          group_results[:output] << test_output
+        end
+      end
+    end
+
+    # Every member in this group resolved via a matched result line -- but a diagnostic
+    # retry running through its own, separately-configured tool (e.g. without the main
+    # :test_fixture's sanitizer options) can complete cleanly and print a legitimate-
+    # looking PASS even when it isn't a trustworthy stand-in for what actually happened.
+    # The same real-status check the main run itself relies on applies here too.
+    if !crashed && @helper.test_crash?( filename, executable, crash_result )
+      crashed = true
+      group_results = @RESULTS_COLLECTOR.new(
+        passed: 0, ignored: 0, failed: group.size,
+        output: group.map { |test_case|
+          "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:FAIL: Test case crashed" \
+          " >> diagnostic retry's own exit status contradicts its reported clean result"
+        }
+      )
+    end
+
+    return [group_results, crashed]
+  end
+
   # Groups test cases so each parameterized test's cases are isolated together as one
   # sub-process run instead of one run per case. Unity's `-n`/`-f` command-line filter
   # parser treats a comma as a separator between multiple OR'd filter clauses, so an
@@ -360,20 +514,30 @@ class GeneratorTestResultsBacktrace
     test_cases.group_by { |test_case| test_case[:test].sub(/\(.*\)\z/, '') }.values
   end
 
-  # Builds the Unity command-line filter argument for isolating one group (see
-  # `group_test_cases`). A non-parameterized (single-member, no-args) group is isolated
-  # with an exact-match filter as before. A parameterized group is isolated with a
-  # non-strict prefix filter on its shared base name -- the only reliable way to select
-  # such a group, since its members' runtime names contain commas.
-  def unity_filter_arg(group)
-    test_name = group.first[:test]
-
-    if test_name.include?('(')
-      base_name = test_name.sub(/\(.*\)\z/, '')
-      %(-f "#{base_name}")
-    else
-      %(-n "#{test_name}")
+  # Builds the Unity command-line filter argument for isolating groups (see
+  # `group_test_cases`). Non-parameterized (single-member, no-args) groups are isolated
+  # with one exact-match filter OR'ing their names -- Unity's strict `-n` matching applies
+  # to each comma-separated clause. A parameterized group is isolated on its own with a
+  # non-strict filter on its shared base name followed by the opening parenthesis of its
+  # arguments -- the only reliable way to select such a group, since its members' runtime
+  # names contain commas. The parenthesis keeps the filter from also selecting other test
+  # cases whose names merely begin with the base name (e.g. `test_foo_bar` for `test_foo`).
+  def unity_filter_arg(groups)
+    parameterized = groups.select { |group| parameterized_group?( group ) }
+
+    if parameterized.empty?
+      return %(-n "#{groups.map { |group| group.first[:test] }.join(',')}")
+    end
+
+    if groups.size > 1
+      raise ArgumentError.new( "Parameterized test cases cannot be selected together with other test cases" )
     end
+
+    return "-f \"#{parameterized.first.first[:test].sub(/\(.*\)\z/, '')}(\""
+  end
+
+  def parameterized_group?(group)
+    return group.first[:test].include?('(')
   end
 
   # Builds a terse crash label from gdb output.
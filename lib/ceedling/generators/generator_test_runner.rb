@@ -30,6 +30,16 @@ class GeneratorTestRunner
     parse_test_file( test_file_contents, preprocessed_file_contents )
   end
 
+  # Serializable (e.g. returned from a worker process) -- parsing parcels are only needed to parse
+  def marshal_dump()
+    return [@unity_runner_generator, @test_cases, @test_cases_internal]
+  end
+
+  def marshal_load(data)
+    @unity_runner_generator, @test_cases, @test_cases_internal = data
+    @parsing_parcels = nil
+  end
+
   def generate(module_name:, runner_filepath:, mocks:, includes:)
     # Actually build the test runner using Unity's test runner generator.
     @unity_runner_generator.generate(
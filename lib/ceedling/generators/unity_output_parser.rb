@@ -0,0 +1,251 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'ceedling/constants'
+require 'ceedling/exceptions'
+
+##
+## Incremental parser for Unity test executable output.
+##
+## Output is fed in arbitrary chunks as a test executable runs (or all at once).
+## Complete lines are classified immediately and never retained:
+##  - Test case result lines (PASS / FAIL / IGNORE) become result entries.
+##  - Unity's statistics footer becomes the final counts.
+##  - Everything else is collected as test stdout up to a line limit.
+##
+## An optional block is called with (status, test_case) as each test case result
+## line is parsed, where status is :pass, :fail, or :ignore.
+##
+## Not constructed by DIY -- one parser is created per test executable run.
+##
+class UnityOutputParser
+
+  # ANSI escape sequences produced by Unity built with UNITY_OUTPUT_COLOR
+  ANSI_ESCAPE = /\e\[[\d;]*[mK]/
+
+  # Line-by-line decomposition of PATTERNS::TEST_STDOUT_STATISTICS
+  STATISTICS_RULE   = /^-+\s*$/
+  STATISTICS_COUNTS = /^\s*(\d+)\s+Tests\s+(\d+)\s+Failures\s+(\d+)\s+Ignored\s*$/i
+  STATISTICS_RESULT = /^\s*(OK|FAIL)\s*$/i
+
+  attr_reader :results
+
+  def initialize(executable:, test_file:, stdout_limit:nil, &on_test_case)
+    @executable = executable
+    @test_file = test_file
+    @stdout_limit = stdout_limit
+    @on_test_case = on_test_case
+
+    @results = {
+      :source    => {:file => test_file, :dirname => File.dirname(test_file), :basename => File.basename(test_file)},
+      :successes => [],
+      :failures  => [],
+      :ignores   => [],
+      :counts    => {:total => 0, :passed => 0, :failed => 0, :ignored  => 0},
+      :stdout    => [],
+      :time      => 0.0
+    }
+
+    # Bytes of an incomplete line (a chunk may end mid-line or mid-character)
+    @partial = ''.b
+    # Lines of a statistics footer seen so far but not yet confirmed
+    @pending = []
+    @statistics = false
+    @stdout_omitted = 0
+    @error = nil
+  end
+
+
+  def <<(chunk)
+    # After a parsing failure, ignore remaining output; `finish()` reports the failure
+    return self if !@error.nil?
+
+    lines = (@partial + chunk.to_s.b).split( "\n", -1 )
+
+    # Last element is an incomplete line (or empty if chunk ended with a newline)
+    @partial = lines.pop() || ''.b
+
+    begin
+      lines.each {|line| parse_line( decode( line ) + "\n" ) }
+    rescue CeedlingException => ex
+      # Raise from `finish()` rather than from within a running executable's output loop
+      @error = ex
+    end
+
+    return self
+  end
+
+
+  # Process any trailing partial line and unconfirmed footer lines.
+  # Returns parsed results.
+  def finish()
+    raise @error if !@error.nil?
+
+    parse_line( decode( @partial ) ) if !@partial.empty?
+    @partial = ''.b
+
+    flush_pending()
+
+    if @stdout_omitted > 0
+      @results[:stdout] << "[#{@stdout_omitted} more lines of test output omitted]"
+    end
+
+    return @results
+  end
+
+
+  def statistics?
+    return @statistics
+  end
+
+
+  ### Private ###
+
+  private
+
+  def decode(line)
+    return line.force_encoding( Encoding::UTF_8 ).scrub()
+  end
+
+
+  def parse_line(raw_line)
+    line = raw_line.gsub( ANSI_ESCAPE, '' )
+    chomped_line = line.chomp
+
+    # Statistics footer handling (only the first footer counts)
+    if !@statistics
+      return if statistics_line?( chomped_line )
+    end
+
+    classify( line, chomped_line )
+  end
+
+
+  # Returns true if the line was consumed as (part of) a statistics footer
+  def statistics_line?(line)
+    if @pending.empty?
+      return false if (line !~ STATISTICS_RULE)
+      @pending << line
+      return true
+    end
+
+    # Blank lines may appear between footer lines
+    if line.strip.empty?
+      @pending << line
+      return true
+    end
+
+    counts = @pending.find {|_line| _line =~ STATISTICS_COUNTS }
+
+    if counts.nil? and (line =~ STATISTICS_COUNTS)
+      @pending << line
+      return true
+    end
+
+    if !counts.nil? and (line =~ STATISTICS_RESULT)
+      counts =~ STATISTICS_COUNTS
+      @results[:counts][:total]   = $1.to_i
+      @results[:counts][:failed]  = $2.to_i
+      @results[:counts][:ignored] = $3.to_i
+      @results[:counts][:passed]  = (@results[:counts][:total] - @results[:counts][:failed] - @results[:counts][:ignored])
+      @statistics = true
+      @pending = []
+      return true
+    end
+
+    # Not a footer after all -- process held lines normally, then reconsider this line
+    flush_pending()
+    return statistics_line?( line )
+  end
+
+
+  def flush_pending()
+    pending = @pending
+    @pending = []
+    pending.each {|line| classify( line + "\n", line ) }
+  end
+
+
+  def classify(line, chomped_line)
+    case chomped_line
+    when /(:IGNORE)/
+      collect( :ignore, @results[:ignores], line )
+
+    when /(:PASS$)/
+      collect( :pass, @results[:successes], line )
+
+    when /(:PASS \(.* ms\)$)/
+      collect( :pass, @results[:successes], line )
+
+    when /(:FAIL)/
+      collect( :fail, @results[:failures], line )
+
+    # Collect up all other output
+    else
+      stdout( chomped_line ) unless chomped_line.empty?
+    end
+  end
+
+
+  def collect(status, list, line)
+    test_case, output = extract_line_elements( line )
+    list << test_case
+    stdout( output ) unless (output.nil? || output.empty?)
+    @on_test_case.call( status, test_case ) if !@on_test_case.nil?
+  end
+
+
+  def stdout(line)
+    if !@stdout_limit.nil? and (@results[:stdout].size >= @stdout_limit)
+      @stdout_omitted += 1
+    else
+      @results[:stdout] << line
+    end
+  end
+
+
+  def extract_line_elements(line)
+    # Handle anything preceding filename in line as extra output to be collected
+    stdout = nil
+    stdout_regex = /(.+)#{Regexp.escape(@test_file)}:[0-9]+:(PASS|IGNORE|FAIL).+/i
+    unity_test_time = 0
+
+    if (line =~ stdout_regex)
+      stdout = $1.clone
+      line = line.sub(/#{Regexp.escape(stdout)}/, '')
+    end
+
+    # Collect up test results minus any extra output
+    elements = (line.strip.split(':'))[1..-1]
+
+    # Find timestamp if available
+    if (elements[-1] =~ / \((\d*(?:\.\d*)?) ms\)/)
+      unity_test_time = $1.to_f / 1000
+      elements[-1].sub!(/ \((\d*(?:\.\d*)?) ms\)/, '')
+    end
+
+    if elements[3..-1]
+      message = (elements[3..-1].join(':')).strip
+    else
+      message = nil
+    end
+
+    components = {
+      :test => elements[1],
+      :line => elements[0].to_i,
+      # Decode any multline strings
+      :message => message.nil? ? nil : message.gsub( NEWLINE_TOKEN, "\n" ),
+      :unity_test_time => unity_test_time
+    }
+
+    return components, stdout if elements.size >= 3
+
+    # Fall through failure case
+    raise CeedlingException.new( "Could not parse results output line \"line\" for `#{@executable}`" )
+  end
+
+end
@@ -6,11 +6,13 @@
 # =========================================================================
 
 require 'pathname'
+require 'digest'
 require 'ceedling/exceptions'
+require 'ceedling/dependency_graph'
 
 class IncludePathinator
 
-  constructor :configurator, :test_context_extractor, :loginator, :file_wrapper
+  constructor :configurator, :test_context_extractor, :loginator, :file_wrapper, :yaml_wrapper
 
   def setup
     # TODO: When Ceedling's base project path handling is resolved, update this value to automatically 
@@ -19,6 +21,10 @@ class IncludePathinator
 
     # Alias for brevity
     @extractor = @test_context_extractor
+
+    # Filepath => contents digest (nil if missing) of sources & headers checked for minimal search paths
+    @digests = {}
+    @digests_lock = Mutex.new
   end
 
   def validate_test_build_directive_paths
@@ -80,4 +86,95 @@ class IncludePathinator
     return paths
   end
 
+
+  # Minimal search paths: the ordered subset of `search_paths` that contains every header
+  # listed in the compiler dependencies files of a test's objects. Searching this subset for
+  # the same #includes finds the same headers -- every search path that was searched before
+  # the one in which a header was found did not contain it.
+  # Returns nil if any dependencies file is missing (e.g. a tool that writes none).
+  def minimize_search_paths(search_paths:, dependencies:)
+    headers = dependency_paths( dependencies )
+    return nil if headers.nil?
+
+    # Directories (absolute) containing the headers and each of their ancestors
+    directories = {}
+    headers.each do |header|
+      directory = File.dirname( File.expand_path( header ) )
+      until directories.key?( directory )
+        directories[directory] = true
+        parent = File.dirname( directory )
+        break if parent == directory
+        directory = parent
+      end
+    end
+
+    return search_paths.select {|path| directories.key?( File.expand_path( path ) )}
+  end
+
+  # Minimal search paths recorded in `filepath` for exactly `search_paths`, `defines`, and `flags`
+  # (or nil). They no longer apply if any of those or any source or header the recording build
+  # depended on has since changed or gone -- a changed file or define may #include a header the
+  # minimal search paths do not cover, or that a search path they leave out would find first.
+  def load_minimal_search_paths(search_paths:, defines:, flags:, filepath:)
+    return nil if !@file_wrapper.exist?( filepath )
+
+    cache = @yaml_wrapper.load( filepath )
+    return nil if !cache.is_a?( Hash ) or (cache[:digest] != compilation_digest( search_paths, defines, flags ))
+    return nil if !cache[:inputs].is_a?( Hash )
+    return nil if cache[:inputs].any? {|input, digest| file_digest( input ) != digest}
+    return cache[:search_paths]
+  end
+
+  # Record `minimal` search paths along with the contents of every source and header listed in
+  # the `dependencies` files of the build that found them
+  def store_minimal_search_paths(search_paths:, defines:, flags:, minimal:, dependencies:, filepath:)
+    inputs = dependency_paths( dependencies ) || []
+
+    @file_wrapper.mkdir( File.dirname( filepath ) )
+    @yaml_wrapper.dump( filepath, {
+      :digest       => compilation_digest( search_paths, defines, flags ),
+      :search_paths => minimal,
+      :inputs       => inputs.map {|input| [input, file_digest( input )]}.to_h
+    })
+  end
+
+  # Many tests share sources & headers (Unity, CMock, project headers) -- each is read once from
+  # the loading of all tests' minimal search paths through recording them anew. Forget digests
+  # before loading so files regenerated since (e.g. by another build context) are read again.
+  def forget_file_digests()
+    @digests_lock.synchronize { @digests.clear() }
+  end
+
+  ### Private ###
+
+  private
+
+  # All sources and headers listed in compiler dependencies files (nil if any file is missing)
+  def dependency_paths(dependencies)
+    paths = []
+
+    dependencies.each do |filepath|
+      return nil if !@file_wrapper.exist?( filepath )
+      paths += DependencyGraph.parse_paths( @file_wrapper.read( filepath ) )
+    end
+
+    return paths.uniq
+  end
+
+  # Everything besides file contents that decides which header an #include finds
+  def compilation_digest(search_paths, defines, flags)
+    return Digest::SHA256.hexdigest( [search_paths, defines, flags].map {|list| list.to_a.join( "\n" )}.join( "\0" ) )
+  end
+
+  # Contents rather than timestamps -- a test build regenerates its mocks and runners every time
+  def file_digest(filepath)
+    digest = @digests_lock.synchronize { @digests.fetch( filepath, :none ) }
+    return digest if digest != :none
+
+    digest = @file_wrapper.exist?( filepath ) ? Digest::SHA256.file( filepath ).hexdigest : nil
+    @digests_lock.synchronize { @digests[filepath] = digest }
+
+    return digest
+  end
+
 end
@@ -0,0 +1,74 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'ceedling/constants'
+
+##
+## Jumbo ("unity") build units.
+##
+## A jumbo unit is a generated C file that #includes several sources so that they
+## are compiled as one translation unit. Headers shared among those sources are
+## then parsed once per unit instead of once per source.
+##
+## Only sources compiled with identical flags and defines may share a unit. Sources
+## that cannot be combined (e.g. same-named static symbols or conflicting macros)
+## are listed for exclusion and compiled on their own.
+##
+class JumboBuilder
+
+  constructor :configurator, :file_wrapper
+
+  # Sources that may be combined: C sources not excluded by any pattern (a filepath
+  # glob or a filename) and not themselves generated by Ceedling
+  def eligible(sources, exclude:)
+    return sources.select do |source|
+      filename = File.basename( source )
+
+      next false if File.extname( source ) != @configurator.extension_source
+      next false if filename.start_with?( PARTIAL_FILENAME_PREFIX, JUMBO_FILENAME_PREFIX )
+      next false if exclude.any? {|pattern| (filename == pattern) || File.fnmatch?( pattern, source, File::FNM_EXTGLOB )}
+      true
+    end
+  end
+
+
+  # Group `sources` into units of at most `size` sources in `build_path`, writing each
+  # unit's C file (only if its contents changed). Returns unit filepath => sources.
+  # Sources left in a unit of one are not combined.
+  def generate(sources:, size:, build_path:)
+    units = {}
+    return units if size < 2
+
+    # Sorted so that units keep the same members from build to build
+    sources.sort.each_slice( size ).with_index( 1 ) do |members, index|
+      next if members.size < 2
+
+      filepath = File.join( build_path, "#{JUMBO_FILENAME_PREFIX}#{index}#{@configurator.extension_source}" )
+      write_unit( filepath, members )
+      units[filepath] = members
+    end
+
+    return units
+  end
+
+  ### Private ###
+
+  private
+
+  def write_unit(filepath, sources)
+    contents = "/* Jumbo build unit generated by Ceedling -- do not edit */\n\n"
+
+    # Absolute paths -- a unit is compiled from the build directory
+    sources.each {|source| contents << "#include \"#{File.expand_path( source )}\"\n" }
+
+    return if @file_wrapper.exist?( filepath ) && (@file_wrapper.read( filepath ) == contents)
+
+    @file_wrapper.mkdir( File.dirname( filepath ) )
+    @file_wrapper.write( filepath, contents )
+  end
+
+end
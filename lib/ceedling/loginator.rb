@@ -5,14 +5,22 @@
 #   SPDX-License-Identifier: MIT
 # =========================================================================
 
+require 'json'
 require 'ceedling/constants'
 
 # Loginator handles console and file output of logging statements
 
 class Loginator
 
+  # Buffered log file content is written once it reaches this size (or the message queue drains)
+  LOGFILE_BUFFER_BYTES = 65536
+
   attr_reader :project_logging
   attr_writer :decorators
+  # Current build stage (build steps are sequential) recorded in structured log entries
+  attr_accessor :stage
+  # Optional compact console progress display (see ProgressRenderer)
+  attr_writer :progress
 
   constructor :verbosinator, :file_wrapper, :system_wrapper
 
@@ -53,6 +61,13 @@ class Loginator
 
     @project_logging = false
     @log_filepath = nil
+    @log_format = :text
+    @stage = nil
+    @progress = nil
+
+    # Persistent log file handle (opened on first write) and pending content
+    @logfile = nil
+    @logfile_buffer = ''
   
     @queue = Queue.new
     @worker = Thread.new do
@@ -77,15 +92,27 @@ class Loginator
               
               # Write to log as though Verbosity::DEBUG (no filtering at all) but without fun characters
               if @project_logging
-                file_msg = message.dup() # Copy for safe inline modifications
-        
-                # Add labels
-                file_msg = format( file_msg, verbosity, label, false )
-        
-                # Note: In practice, file-based logging only works with trailing newlines (i.e. `log()` calls)
-                #       `out()` calls will be a little ugly in the log file, but these are typically only
-                #       used for console logging anyhow.
-                logfile( sanitize( file_msg, false ), extract_stream_name( stream ) )
+                if message.nil?
+                  # Structured-only event (see `event()`)
+                  logfile_json( item ) if @log_format == :json
+                else
+                  file_msg = message.dup() # Copy for safe inline modifications
+          
+                  # Add labels
+                  file_msg = format( file_msg, verbosity, label, false )
+          
+                  # Note: In practice, file-based logging only works with trailing newlines (i.e. `log()` calls)
+                  #       `out()` calls will be a little ugly in the log file, but these are typically only
+                  #       used for console logging anyhow.
+                  if @log_format == :json
+                    logfile_json( item.merge( :message => sanitize( file_msg, false ) ) )
+                  else
+                    logfile( sanitize( file_msg, false ), extract_stream_name( stream ) )
+                  end
+                end
+
+                # Write buffered log content in batches -- whenever a batch is large or no messages are waiting
+                logfile_flush() if (@logfile_buffer.bytesize >= LOGFILE_BUFFER_BYTES) or @queue.empty?
               end
         
               # Output to console -- desired verbosity was checked at enqueueing
@@ -93,14 +120,19 @@ class Loginator
                 # Add labels and fun characters
                 console_msg = format( message, verbosity, label, @decorators )
 
-                # Write to output stream after optionally removing any problematic characters
-                stream.print( sanitize( console_msg, @decorators ) )
-
-                # Flush immediately.
-                # Required on Windows where $stdout connected to a pipe is fully buffered.
-                # Without an explicit flush, messages sit in Ruby's IO buffer and can be lost
-                # when the process exits before the C runtime drains the buffer.
-                stream.flush
+                if item[:progress]
+                  # Progress display replaces routine messages logged during parallel work
+                  @progress.print_above( stream, sanitize( console_msg, @decorators ) ) if (verbosity < Verbosity::NORMAL)
+                else
+                  # Write to output stream after optionally removing any problematic characters
+                  stream.print( sanitize( console_msg, @decorators ) )
+
+                  # Flush immediately.
+                  # Required on Windows where $stdout connected to a pipe is fully buffered.
+                  # Without an explicit flush, messages sit in Ruby's IO buffer and can be lost
+                  # when the process exits before the C runtime drains the buffer.
+                  stream.flush
+                end
               end
             end
           rescue ThreadError
@@ -110,6 +142,9 @@ class Loginator
           end
         end
       end
+
+      # Queue closed (or worker failed) -- don't lose anything already logged
+      logfile_close()
     end
   end
 
@@ -122,10 +157,65 @@ class Loginator
     end
   end
 
-  def set_logfile( log_filepath )
+  # `format` is :text (human-readable) or :json (one JSON object per line for machine analysis)
+  def set_logfile( log_filepath, format=:text )
     if !log_filepath.empty?
       @project_logging = true
       @log_filepath = log_filepath
+      @log_format = format.to_sym
+    end
+  end
+
+
+  # Fields (e.g. :test) recorded in structured log entries for messages logged by the
+  # current thread within the block
+  def with_fields(fields)
+    previous = Thread.current[:ceedling_log_fields]
+    Thread.current[:ceedling_log_fields] = (previous || {}).merge( fields )
+    yield
+  ensure
+    Thread.current[:ceedling_log_fields] = previous
+  end
+
+
+  # Record fields (e.g. :tool and :duration of a tool execution) in a structured log only.
+  # Never written to the console or a text log file.
+  def event(name, fields={})
+    return unless @project_logging and (@log_format == :json)
+
+    @queue << {
+      :event => name,
+      :fields => fields,
+      :verbosity => Verbosity::DEBUG,
+      :label => LogLabels::NONE
+    }.merge( structured_fields() )
+  end
+
+
+  # Collect rather than process anything logged within the block -- for a forked worker
+  # process, which has no logging worker thread. Returns [block result, collected items]
+  # where the items are serializable (see `replay()`).
+  def capture()
+    queue = @queue
+    @queue = []
+
+    result = yield
+
+    items = @queue.map do |item|
+      next item if item[:stream].nil?
+      item.merge( :stream => ((item[:stream].fileno == 2) ? :stderr : :stdout) )
+    end
+
+    return [result, items]
+  ensure
+    @queue = queue
+  end
+
+  # Log items collected by `capture()`
+  def replay(items)
+    items.each do |item|
+      item = item.merge( :stream => ((item[:stream] == :stderr) ? $stderr : $stdout) ) if !item[:stream].nil?
+      @queue << item
     end
   end
 
@@ -176,6 +266,9 @@ class Loginator
       :label => label,
       :stream => stream
     }
+    item.merge!( structured_fields() ) if (@log_format == :json)
+    # Decided as logged -- the display may finish before the queue catches up
+    item[:progress] = true if (!@progress.nil? and @progress.active?)
     @queue << item
   end
 
@@ -226,6 +319,9 @@ class Loginator
       :label => label,
       :stream => stream
     }
+    item.merge!( structured_fields() ) if (@log_format == :json)
+    # Decided as logged -- the display may finish before the queue catches up
+    item[:progress] = true if (!@progress.nil? and @progress.active?)
     @queue << item
   end
 
@@ -314,6 +410,14 @@ class Loginator
 
   private
 
+  # Context captured at logging time from the logging thread
+  def structured_fields()
+    fields = { :time => Time.now, :stage => @stage }
+    fields.merge!( Thread.current[:ceedling_log_fields] ) if !Thread.current[:ceedling_log_fields].nil?
+    return fields
+  end
+
+
   def insert_prepend(prepend, string)
     leading, rest = string.match(/\A(\n*)(.*)\z/m).captures
     return leading + prepend + rest
@@ -419,7 +523,53 @@ class Loginator
     # <IO:$stdout> May  1 22:20:40 2024 | Compiling TestUsartModel::unity.c...
     # <IO:$stdout> May  1 22:20:40 2024 | Compiling TestUsartModel::cmock.c...
 
-    @file_wrapper.write( @log_filepath, output, 'a' )
+    @logfile_buffer << output
+  end
+
+
+  def logfile_json(item)
+    entry = {
+      :time => item[:time].strftime( '%Y-%m-%dT%H:%M:%S.%L%z' ),
+      :verbosity => VERBOSITY_OPTIONS.key( item[:verbosity] ),
+      :stage => item[:stage],
+      :test => item[:test]
+    }
+
+    if item[:event].nil?
+      entry[:stream] = extract_stream_name( item[:stream] ) if !item[:stream].nil?
+      entry[:message] = item[:message].strip
+    else
+      entry[:event] = item[:event]
+      entry.merge!( item[:fields] )
+    end
+
+    @logfile_buffer << JSON.generate( entry.compact ) << "\n"
+  end
+
+
+  def logfile_flush()
+    return if @logfile_buffer.empty?
+
+    # Open once and keep open for the life of the build
+    @logfile = @file_wrapper.open( @log_filepath, 'a' ) if @logfile.nil?
+    @logfile.write( @logfile_buffer )
+    @logfile.flush()
+
+    @logfile_buffer = ''
+  end
+
+
+  def logfile_close()
+    return if !@project_logging
+
+    begin
+      logfile_flush()
+      @logfile.close() if !@logfile.nil?
+    rescue StandardError => e
+      puts e.inspect
+    end
+
+    @logfile = nil
   end
 
 end
@@ -6,6 +6,7 @@
 # =========================================================================
 
 require 'set'
+require 'digest'
 require 'rake' # .ext()
 require 'ceedling/includes/includes'
 require 'ceedling/partials/partials'
@@ -24,6 +25,11 @@ class Partializer
   def setup()
     # Alias
     @helper = @partializer_helper
+
+    # Extracted C module contents of preprocessed Partial source & header files shared by
+    # all tests Partialing the same module (see `extract_module_contents()`)
+    @extractions = {}
+    @extractions_lock = Mutex.new
   end
 
   def validate_config(c_module:, config:, name:)
@@ -222,45 +228,7 @@ class Partializer
       # Do nothing if there's no directives-only preprocessed filepath (e.g. no source only header for a Partial mock)
       next unless c_file.directives_only_filepath
 
-      c_module = @c_extractor.from_file( c_file.directives_only_filepath )
-
-      _log_module_contents(name, config.module, file_type, c_module)
-
-      # Update function signatures from fully preprocessed output when available.
-      # Replaces signature/decorators/signature_stripped (but NOT code_block) so that
-      # macros wrapping `static` and `inline` are resolved before visibility filtering.
-      if c_file.full_expansion_filepath
-        @helper.update_signatures_from_full_expansion(
-          funcs:                   c_module.function_definitions,
-          full_expansion_filepath: c_file.full_expansion_filepath,
-          name:                    name,
-          module_name:             config.module,
-          file_type:               file_type
-        )
-      end
-
-      # Align extracted function definitions with line markers in preprocessor output.
-      # This perfectly remaps functions found in expanded preprocessor output with 
-      # original source location.
-      # This routine depends on original, unaltered function definitions.
-      @helper.associate_function_line_numbers(
-        name: name,
-        funcs: c_module.function_definitions,
-        filepath: c_file.filepath,
-        fallback: fallback
-      )
-
-      # 1. Find any function-scope static variable declarations.
-      # 2. Replace them in function definitions with no-ops (for proper coverage reporting).
-      # 3. Promote the function-scoped variables to be module-level variables.
-      decls = @helper.extract_function_scope_static_vars(
-        c_module.function_definitions,
-        name: name, module_name: config.module, file_type: file_type
-      )
-      c_module.variable_declarations.concat(decls)
-      c_module.element_sequence.concat(decls) unless decls.empty?
-
-      contents << c_module
+      contents << extract_c_file_contents( name, config.module, c_file, file_type, fallback )
     end
 
     # Use `+` operator for CModule to merge everything
@@ -398,6 +366,83 @@ class Partializer
 
   private
 
+  # Each test Partialing the same module preprocesses its source & header itself, but with the
+  # same search paths and defines their preprocessed contents are identical. Extraction (with
+  # its full expansion and line number passes) depends only on those contents, so it runs
+  # once per distinct set of contents and tests share the results. Tests only ever combine
+  # the shared contents into a new CModule (see `CModule#+`) and never modify its elements.
+  def extract_c_file_contents(name, module_name, c_file, file_type, fallback)
+    key = extraction_key( name, c_file, file_type, fallback )
+    return _extract_c_file_contents( name, module_name, c_file, file_type, fallback ) if key.nil?
+
+    extraction = @extractions_lock.synchronize { @extractions[key] ||= { :lock => Mutex.new, :c_module => nil } }
+
+    # Tests Partialing the same module at the same time wait on one extraction
+    extraction[:lock].synchronize do
+      extraction[:c_module] ||= _extract_c_file_contents( name, module_name, c_file, file_type, fallback )
+    end
+
+    return extraction[:c_module]
+  end
+
+  # Digest of everything extraction reads. Nil (no sharing) if preprocessed output is not on disk.
+  def extraction_key(name, c_file, file_type, fallback)
+    return nil if !File.exist?( c_file.directives_only_filepath )
+
+    # Preprocessed output with line markers used to locate functions in the original file
+    raw_filepath = @file_path_utils.form_preprocessed_file_raw_directives_only_filepath( c_file.filepath, name )
+
+    digest = Digest::SHA256.new
+    digest << [file_type, c_file.filepath, fallback].join( "\0" ) << "\0"
+    [c_file.directives_only_filepath, c_file.full_expansion_filepath, raw_filepath].each do |filepath|
+      digest << ((!filepath.nil? and File.exist?( filepath )) ? Digest::SHA256.file( filepath ).hexdigest : '-') << "\0"
+    end
+
+    return digest.hexdigest
+  end
+
+  def _extract_c_file_contents(name, module_name, c_file, file_type, fallback)
+    c_module = @c_extractor.from_file( c_file.directives_only_filepath )
+
+    _log_module_contents(name, module_name, file_type, c_module)
+
+    # Update function signatures from fully preprocessed output when available.
+    # Replaces signature/decorators/signature_stripped (but NOT code_block) so that
+    # macros wrapping `static` and `inline` are resolved before visibility filtering.
+    if c_file.full_expansion_filepath
+      @helper.update_signatures_from_full_expansion(
+        funcs:                   c_module.function_definitions,
+        full_expansion_filepath: c_file.full_expansion_filepath,
+        name:                    name,
+        module_name:             module_name,
+        file_type:               file_type
+      )
+    end
+
+    # Align extracted function definitions with line markers in preprocessor output.
+    # This perfectly remaps functions found in expanded preprocessor output with 
+    # original source location.
+    # This routine depends on original, unaltered function definitions.
+    @helper.associate_function_line_numbers(
+      name: name,
+      funcs: c_module.function_definitions,
+      filepath: c_file.filepath,
+      fallback: fallback
+    )
+
+    # 1. Find any function-scope static variable declarations.
+    # 2. Replace them in function definitions with no-ops (for proper coverage reporting).
+    # 3. Promote the function-scoped variables to be module-level variables.
+    decls = @helper.extract_function_scope_static_vars(
+      c_module.function_definitions,
+      name: name, module_name: module_name, file_type: file_type
+    )
+    c_module.variable_declarations.concat(decls)
+    c_module.element_sequence.concat(decls) unless decls.empty?
+
+    return c_module
+  end
+
   # Log all user-defined (non-function) C content extracted from a module's source/header at OBNOXIOUS level.
   # Covers the four categories that are injected into generated Partial files:
   # variable declarations, type definitions, macro definitions, and aggregate definitions
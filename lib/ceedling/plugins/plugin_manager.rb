@@ -119,6 +119,8 @@ class PluginManager
     execute_plugins(:post_test_fixture_execute, arg_hash)
   end
 
+  def post_test_case_execute(arg_hash); execute_plugins(:post_test_case_execute, arg_hash); end
+
   def pre_test(test); execute_plugins(:pre_test, test); end
   def post_test(test); execute_plugins(:post_test, test); end
 
@@ -11,9 +11,13 @@ require 'ceedling/exceptions'
 
 class PluginReportinatorHelper
     
-  constructor :configurator, :yaml_wrapper, :file_wrapper
+  constructor :configurator, :test_results_store, :file_wrapper
   
   def fetch_results(results_path, options)
+    # Results written (or already loaded) during this build need no file access at all
+    results = @test_results_store.fetch( results_path )
+    return results if !results.nil?
+
     # Create the results filepaths
     pass_path = results_path.ext( @configurator.extension_testpass )
     fail_path = results_path.ext( @configurator.extension_testfail )
@@ -40,22 +44,24 @@ class PluginReportinatorHelper
       # Handle if both files exists and return the newer results
       if pass_exists and fail_exists
         if @file_wrapper.newer?( pass_path, fail_path )
-          return @yaml_wrapper.load( pass_path )
+          return @test_results_store.load( pass_path )
         else
-          return @yaml_wrapper.load( fail_path )
+          return @test_results_store.load( fail_path )
         end
       end
 
       # Return success results
-      return @yaml_wrapper.load(pass_path) if pass_exists
+      return @test_results_store.load(pass_path) if pass_exists
 
       # Return fail results
-      return @yaml_wrapper.load(fail_path) if fail_exists
+      return @test_results_store.load(fail_path) if fail_exists
     rescue YamlLoadException => e
       raise YamlLoadException.new(
         reason: e.reason, source: e.source, original_error: e.original_error,
         message: "Generated test results file is corrupted or unreadable ⏩️ #{e.message}"
       )
+    rescue CeedlingException => e
+      raise CeedlingException.new( "Generated test results file is corrupted or unreadable ⏩️ #{e.message}" )
     end
 
     # Safety fall-through (flow control should never get here)
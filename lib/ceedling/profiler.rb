@@ -0,0 +1,250 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'json'
+require 'ceedling/constants'
+
+##
+## Build profiler (`--profile`).
+##
+## Records nested spans of wall time:
+##  - :stage -- each test build pipeline stage
+##  - :item  -- each item of parallel work within a batch (tagged with its test and file)
+##  - :tool  -- each tool execution (subprocess) within an item
+##
+## Time within an item not spent in its tools is Ruby-side time. Stages also record
+## GC time and objects allocated; these are process-wide counts as parallel items share
+## one process. Items run by worker processes are recorded as a whole (`record()`) --
+## neither their tools nor their GC activity are seen.
+##
+## At the end of a build a summary sorted by duration is written to the console and to
+## `profile.txt`, and all spans are written as Chrome trace events (`profile.json`)
+## viewable in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+##
+class Profiler
+
+  # Slowest items listed in the summary
+  SUMMARY_ITEMS = 20
+
+  constructor :loginator, :file_wrapper
+
+  def setup()
+    @enabled = false
+    @path = nil
+    @spans = []
+    @threads = {}
+    @stage = nil
+    @lock = Mutex.new
+    @origin = clock()
+  end
+
+
+  # `path` is the directory profile reports are written to
+  def enable(path)
+    @enabled = true
+    @path = path
+    @gc = gc_counts()
+  end
+
+  def enabled?
+    return @enabled
+  end
+
+
+  # Record the block as a span of `category` (:stage, :item, or :tool) named `name`.
+  # `args` tag the span (e.g. :test, :file). Returns the block's result.
+  def span(name, category:, args: {})
+    return yield if !@enabled
+
+    span = {
+      :name     => name.to_s,
+      :category => category,
+      :args     => args.compact,
+      :stage    => @stage&.[]( :name ),
+      :within   => @stage,
+      :tid      => thread_index(),
+      :tools    => 0.0,
+      :children => []
+    }
+
+    stack = (Thread.current[:ceedling_profile_spans] ||= [])
+    parent = stack.last
+    stack.push( span )
+
+    if category == :stage
+      @stage = span
+      gc = gc_counts()
+    end
+
+    span[:start] = clock()
+
+    begin
+      return yield
+    ensure
+      span[:duration] = clock() - span[:start]
+      stack.pop
+
+      if category == :stage
+        @stage = nil
+        span[:gc_time], span[:allocated] = gc_counts().zip( gc ).map {|now, before| now - before}
+      end
+
+      # Tool time accumulates through enclosing spans -- including the stage of parallel items
+      # on other threads (an item's or stage's Ruby time excludes it)
+      if category == :tool
+        enclosing = stack.dup
+        enclosing << @stage if !@stage.nil? and enclosing.none? {|other| other.equal?( @stage )}
+        @lock.synchronize { enclosing.each {|other| other[:tools] += span[:duration]} }
+        parent[:children] << span[:name] if !parent.nil?
+      end
+
+      @lock.synchronize { @spans << span }
+    end
+  end
+
+
+  # Record a span that just finished after `duration` seconds, timed elsewhere (e.g. an item run
+  # by a worker process). `track` distinguishes the trace row of each such worker.
+  def record(name, category:, duration:, track:, args: {})
+    return if !@enabled
+
+    span = {
+      :name     => name.to_s,
+      :category => category,
+      :args     => args.compact,
+      :stage    => @stage&.[]( :name ),
+      :within   => @stage,
+      :tid      => thread_index( track ),
+      :tools    => 0.0,
+      :children => [],
+      :start    => clock() - duration,
+      :duration => duration
+    }
+
+    @lock.synchronize { @spans << span }
+  end
+
+
+  # Write reports and log the summary
+  def report()
+    return if !@enabled
+
+    spans = @lock.synchronize { @spans.dup }
+    summary = summarize( spans )
+
+    @file_wrapper.mkdir( @path )
+    @file_wrapper.write( File.join( @path, PROFILE_SUMMARY_FILENAME ), summary )
+    @file_wrapper.write( File.join( @path, PROFILE_TRACE_FILENAME ), JSON.generate( trace( spans ) ) )
+
+    @loginator.log( "\n" + summary, Verbosity::NORMAL, LogLabels::NONE )
+    @loginator.log( "Profile written to #{File.join( @path, PROFILE_TRACE_FILENAME )}\n", Verbosity::NORMAL, LogLabels::NONE )
+  end
+
+  ### Private ###
+
+  private
+
+  def clock()
+    return Process.clock_gettime( Process::CLOCK_MONOTONIC )
+  end
+
+  # [GC time (seconds), objects allocated] for the process so far
+  def gc_counts()
+    stat = GC.stat
+    return [(stat[:time] || 0) / 1000.0, stat[:total_allocated_objects]]
+  end
+
+  # Small, stable trace thread IDs (per thread or per `track`)
+  def thread_index(track=nil)
+    key = track.nil? ? Thread.current.object_id : [:track, track]
+    @lock.synchronize { return (@threads[key] ||= @threads.size + 1) }
+  end
+
+  def summarize(spans)
+    stages = spans.select {|span| span[:category] == :stage}
+    items  = spans.select {|span| span[:category] == :item}
+    tools  = spans.select {|span| span[:category] == :tool}
+
+    gc_time, allocated = gc_counts().zip( @gc ).map {|now, before| now - before}
+
+    lines = []
+    lines << "PROFILE: #{seconds( clock() - @origin )} wall, #{seconds( gc_time )} GC, #{allocated} objects allocated"
+    lines << ''
+
+    lines << 'Stages (Items: summed item wall time; Ruby: item or stage time not spent in tools)'
+    lines << format( '  %-46s %10s %10s %10s %10s %10s %12s', 'Stage', 'Wall', 'Items', 'Tools', 'Ruby', 'GC', 'Allocated' )
+    stages.sort_by {|stage| -stage[:duration]}.each do |stage|
+      stage_items = items.select {|item| item[:within].equal?( stage )}
+      busy = stage_items.empty? ? stage[:duration] : stage_items.sum {|item| item[:duration]}
+
+      lines << format( '  %-46s %10s %10s %10s %10s %10s %12d',
+        stage[:name][0, 46],
+        seconds( stage[:duration] ),
+        stage_items.empty? ? '-' : seconds( busy ),
+        seconds( stage[:tools] ),
+        seconds( [busy - stage[:tools], 0.0].max ),
+        seconds( stage[:gc_time] ),
+        stage[:allocated]
+      )
+    end
+    lines << ''
+
+    lines << "Slowest items (of #{items.size})"
+    lines << format( '  %10s %10s %10s  %s', 'Wall', 'Tools', 'Ruby', 'Item' )
+    items.sort_by {|item| -item[:duration]}.first( SUMMARY_ITEMS ).each do |item|
+      label = [item[:stage], item[:args][:test], item[:args][:file]].compact.join( ' | ' )
+      label += " [#{item[:children].uniq.join( ', ' )}]" if !item[:children].empty?
+      lines << format( '  %10s %10s %10s  %s',
+        seconds( item[:duration] ),
+        seconds( item[:tools] ),
+        seconds( [item[:duration] - item[:tools], 0.0].max ),
+        label
+      )
+    end
+    lines << ''
+
+    lines << 'Tools'
+    lines << format( '  %-46s %8s %10s %10s %10s', 'Tool', 'Count', 'Total', 'Mean', 'Max' )
+    tools.group_by {|tool| tool[:name]}.sort_by {|_, runs| -runs.sum {|run| run[:duration]}}.each do |name, runs|
+      durations = runs.map {|run| run[:duration]}
+      lines << format( '  %-46s %8d %10s %10s %10s',
+        name[0, 46], runs.size, seconds( durations.sum ), seconds( durations.sum / durations.size ), seconds( durations.max )
+      )
+    end
+
+    return lines.join( "\n" ) + "\n"
+  end
+
+  def seconds(value)
+    return format( '%.3fs', value )
+  end
+
+  # Chrome trace event format: complete ('X') events in microseconds
+  def trace(spans)
+    events = spans.map do |span|
+      args = span[:args].dup
+      args[:stage] = span[:stage] if (span[:category] != :stage) and !span[:stage].nil?
+      args[:ruby_s] = [span[:duration] - span[:tools], 0.0].max.round( 6 ) if span[:category] != :tool
+      args[:gc_s] = span[:gc_time].round( 6 ) if span.key?( :gc_time )
+      args[:allocated] = span[:allocated] if span.key?( :allocated )
+
+      {
+        :name => span[:name],
+        :cat  => span[:category].to_s,
+        :ph   => 'X',
+        :ts   => ((span[:start] - @origin) * 1_000_000).round,
+        :dur  => (span[:duration] * 1_000_000).round,
+        :pid  => Process.pid,
+        :tid  => span[:tid],
+        :args => args
+      }
+    end
+
+    return { :traceEvents => events.sort_by {|event| event[:ts]}, :displayTimeUnit => 'ms' }
+  end
+
+end
@@ -0,0 +1,176 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'io/console'
+require 'ceedling/constants'
+
+##
+## Compact console progress display for parallel build steps.
+##
+## While a batch of parallel work runs, Loginator suppresses per-item console
+## messages (e.g. "Compiling Foo.c...") and this renderer instead maintains a
+## single status line -- stage, done/total, active jobs, and ETA -- redrawn at a
+## fixed rate. Errors and warnings are printed above the status line. Log files
+## still receive every message.
+##
+## Only enabled on request, when $stdout is a terminal, and at verbosity no
+## higher than normal (more verbose output is wanted line by line).
+##
+class ProgressRenderer
+
+  REFRESH_INTERVAL_S = 0.1
+
+  constructor :loginator, :verbosinator
+
+  def setup()
+    @enabled = false
+    @lock = Mutex.new
+    @batch = nil
+    @depth = 0
+    @ticker = nil
+    @drawn = ''
+  end
+
+
+  def enable()
+    return if !$stdout.tty?
+    return if @verbosinator.should_output?( Verbosity::OBNOXIOUS )
+
+    @enabled = true
+    @loginator.progress = self
+  end
+
+
+  # True while a batch is displayed (Loginator checks this as messages are logged)
+  def active?
+    return @enabled && !@batch.nil?
+  end
+
+
+  def start_batch(total:)
+    return if !@enabled
+
+    @lock.synchronize do
+      # Nested batches count toward the outermost batch
+      @depth += 1
+      return if @depth > 1
+
+      @batch = {
+        :stage   => @loginator.stage.to_s.strip,
+        :total   => total,
+        :done    => 0,
+        :active  => 0,
+        :started => SystemWrapper.time_stopwatch_s()
+      }
+    end
+
+    @ticker = Thread.new do
+      loop do
+        sleep( REFRESH_INTERVAL_S )
+        finished = @lock.synchronize do
+          draw() if !@batch.nil?
+          @batch.nil?
+        end
+        break if finished
+      end
+    end
+  end
+
+
+  def job_started()
+    @lock.synchronize { @batch[:active] += 1 if !@batch.nil? and (@depth == 1) }
+  end
+
+
+  def job_finished()
+    @lock.synchronize do
+      return if @batch.nil? or (@depth > 1)
+      @batch[:active] -= 1
+      @batch[:done] += 1
+    end
+  end
+
+
+  def finish_batch()
+    return if !@enabled
+
+    ticker = nil
+
+    @lock.synchronize do
+      @depth -= 1
+      return if @depth > 0
+
+      @batch = nil
+      clear()
+      $stdout.flush()
+      ticker = @ticker
+      @ticker = nil
+    end
+
+    ticker.join() if !ticker.nil?
+  end
+
+
+  # Print a message without disturbing the status line
+  def print_above(stream, message)
+    @lock.synchronize do
+      clear()
+      stream.print( message )
+      stream.flush()
+      draw() if !@batch.nil?
+    end
+  end
+
+
+  ### Private ###
+
+  private
+
+  def draw()
+    line = status_line()
+    return if line == @drawn
+
+    $stdout.print( "\r\e[K" + line )
+    $stdout.flush()
+    @drawn = line
+  end
+
+
+  def clear()
+    return if @drawn.empty?
+    $stdout.print( "\r\e[K" )
+    @drawn = ''
+  end
+
+
+  def status_line()
+    batch = @batch
+    elapsed = SystemWrapper.time_stopwatch_s() - batch[:started]
+
+    eta = '--:--'
+    if batch[:done] > 0
+      # Throughput so far (accounts for however many jobs run in parallel)
+      remaining = (elapsed / batch[:done]) * (batch[:total] - batch[:done])
+      eta = '%d:%02d' % remaining.round.divmod( 60 )
+    end
+
+    line = "#{@loginator.decorate( '', LogLabels::RUN )}#{batch[:stage]} | #{batch[:done]}/#{batch[:total]} done | #{batch[:active]} active | ETA #{eta}"
+
+    # Never wrap -- a wrapped line can't be redrawn in place
+    return line[0, [terminal_width() - 1, 0].max]
+  end
+
+
+  def terminal_width()
+    columns = $stdout.winsize[1]
+    # Some terminals (e.g. pseudo-terminals without a size) report zero columns
+    return (columns > 0) ? columns : 80
+  rescue StandardError
+    return 80
+  end
+
+end
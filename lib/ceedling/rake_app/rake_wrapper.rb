@@ -29,6 +29,20 @@ class RakeWrapper
     return Rake::Task.tasks
   end
 
+  # Run a task's actions whether or not Rake considers it needed. Anything that later
+  # depends on it does not run them again.
+  def execute(task)
+    self[task].execute()
+    clear_actions( task )
+  end
+
+  # Drop a task's actions for the rest of this build (its outputs are known to be current).
+  # It remains a prerequisite of whatever depends on it, so its timestamp still counts.
+  # Rake applies a matching rule to a task it executes with no actions, so a no-op is left.
+  def clear_actions(task)
+    self[task].clear_actions().enhance { }
+  end
+
   def create_file_task(file_task, dependencies)
     file(file_task => dependencies)
   end
@@ -36,6 +36,17 @@ def log_runtime(run, start_time_s, end_time_s, enabled)
   @ceedling[:loginator].log( "\nCeedling #{run} completed in #{duration}", Verbosity::NORMAL)
 end
 
+# Profile (`--profile`) & explain (`--explain`) reports are informational -- never fail a build over them
+def analysis_reports()
+  {:profiler => 'build profile', :explainer => 'build explanations'}.each do |object, report|
+    begin
+      @ceedling[object].report()
+    rescue StandardError => ex
+      @ceedling[:loginator].log( "Could not write #{report}: #{ex.message}", Verbosity::COMPLAIN )
+    end
+  end
+end
+
 start_time = nil # Outside scope of exception handling
 
 # Top-level exception handling for any otherwise un-handled exceptions, particularly around startup
@@ -125,6 +136,7 @@ END {
         @ceedling[:plugin_manager].post_build( SystemWrapper.time_stopwatch_s() )
         @ceedling[:plugin_manager].print_plugin_failures
       end
+      analysis_reports()
       ops_done = SystemWrapper.time_stopwatch_s()
       log_runtime( 'operations', start_time, ops_done, CEEDLING_APPCFG.build_tasks? )
       test_failures_handler() if @ceedling[:rake_invocation_tracker].test_build_invoked?
@@ -146,6 +158,7 @@ END {
     rescue => ex
       boom_handler( @ceedling[:loginator], ex)
     ensure
+      analysis_reports()
       @ceedling[:loginator].wrapup
       exit(1)
     end
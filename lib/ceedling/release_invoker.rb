@@ -10,7 +10,19 @@ require 'ceedling/constants'
 
 class ReleaseInvoker
 
-  constructor :configurator, :batchinator, :reportinator, :loginator, :rake_wrapper, :file_path_utils, :file_wrapper
+  constructor :configurator,
+              :batchinator,
+              :reportinator,
+              :loginator,
+              :rake_wrapper,
+              :dependency_graph,
+              :jumbo_builder,
+              :generator,
+              :flaginator,
+              :defineinator,
+              :file_finder,
+              :file_path_utils,
+              :file_wrapper
 
   def collect_release_build_objects()
     objects = []
@@ -32,18 +44,90 @@ class ReleaseInvoker
     return objects    
   end
 
+  # Returns the objects to link (including any jumbo build units)
   def setup_and_invoke_objects( files )
     objects = @file_path_utils.form_release_build_objects_filelist( files )
+    detection = @configurator.release_build_change_detection
+
+    # Jumbo build unit object => [unit source, sources it combines]
+    units = generate_jumbo_units( objects )
+    units.each {|_, (_, sources)| objects -= @file_path_utils.form_release_build_objects_filelist( sources )}
+    objects += units.keys
+
+    # Objects with a dependencies file from a previous build are rebuilt per the dependency
+    # graph (sources & headers). Others (first build, assembly, tools writing no dependencies
+    # file) are left to Rake's timestamp comparison against their source.
+    @dependency_graph.load( objects.map {|object| [object, @file_path_utils.form_release_dependencies_filepath( object )]} )
+
+    stale = {}
+    objects.each do |object|
+      if @dependency_graph.tracked?( object )
+        stale[object] = @dependency_graph.stale?(
+          object,
+          detection: detection,
+          fingerprint: @file_path_utils.form_release_fingerprint_filepath( object )
+        )
+      elsif units.key?( object )
+        # Jumbo build units have no Rake task to compare timestamps
+        unit, sources = units[object]
+        stale[object] = !@file_wrapper.exist?( object ) || ([unit] + sources).any? {|source| @file_wrapper.newer?( source, object )}
+      end
+    end
 
     @batchinator.build_step( "Building Objects" ) do
       @batchinator.exec(workload: :compile, things: objects) do |object|
-        @rake_wrapper[object].invoke
+        if units.key?( object )
+          generate_object( source: units[object][0], object: object ) if stale[object]
+          @rake_wrapper.clear_actions( object )
+        else
+          case stale[object]
+          when nil   then @rake_wrapper[object].invoke
+          when true  then @rake_wrapper.execute( object )
+          when false then @rake_wrapper.clear_actions( object )
+          end
+        end
+
+        if (detection == :checksum) and (stale[object] != false)
+          @dependency_graph.record(
+            object,
+            @file_path_utils.form_release_dependencies_filepath( object ),
+            @file_path_utils.form_release_fingerprint_filepath( object )
+          )
+        end
       end    
     end
 
     return objects
   end
 
+  def generate_object( source:, object: )
+    if @file_wrapper.extname( source ) != @configurator.extension_assembly
+      @generator.generate_object_file_c(
+        tool:         @configurator.tools_release_compiler,
+        module_name:  File.basename( source ).ext(), # Source filename as module name
+        context:      RELEASE_SYM,
+        source:       source,
+        object:       object,
+        search_paths: @configurator.collection_paths_include,
+        flags:        @flaginator.flag_down( context:RELEASE_SYM, operation:OPERATION_COMPILE_SYM ),
+        defines:      @defineinator.defines( subkey:RELEASE_SYM ),
+        list:         @file_path_utils.form_release_build_list_filepath( object ),
+        dependencies: @file_path_utils.form_release_dependencies_filepath( object ) )
+    else
+      @generator.generate_object_file_asm(
+        tool:         @configurator.tools_release_assembler,
+        module_name:  File.basename( source ).ext(), # Source filename as module name
+        context:      RELEASE_SYM,
+        source:       source,
+        object:       object,
+        search_paths: @configurator.collection_paths_include,
+        flags:        @flaginator.flag_down( context:RELEASE_SYM, operation:OPERATION_ASSEMBLE_SYM ),
+        defines:      @defineinator.defines( subkey:RELEASE_SYM ),
+        list:         @file_path_utils.form_release_build_list_filepath( object ),
+        dependencies: @file_path_utils.form_release_dependencies_filepath( object ) )
+    end
+  end
+
   def setup_and_invoke_binary( filepath )
     @batchinator.build_step( "Building Binary" ) do
       @rake_wrapper[filepath].invoke
@@ -109,4 +193,36 @@ class ReleaseInvoker
     objects   = sorted_objects[:objects]   || []
     return objects, libraries
   end
+
+  ### Private ###
+
+  private
+
+  # Release compilation flags & defines apply to all sources alike, so any eligible
+  # sources may share a jumbo build unit
+  def generate_jumbo_units(objects)
+    size = @configurator.release_build_jumbo_size
+    return {} if size < 2
+
+    sources = objects.filter_map do |object|
+      @file_finder.find_build_input_file( filepath: object, complain: :ignore, context: RELEASE_SYM )
+    end
+
+    units = @jumbo_builder.generate(
+      sources:    @jumbo_builder.eligible( sources, exclude: @configurator.release_build_jumbo_exclude ),
+      size:       size,
+      build_path: @configurator.project_release_build_output_path
+    )
+
+    return units.to_h do |unit, _sources|
+      object = @file_path_utils.form_release_build_objects_filelist( [unit] )[0]
+
+      # A unit's object is no rule target (its source is not among the release build input).
+      # Its file task lets the release target depend on it like any other object.
+      @rake_wrapper.create_file_task( object, [unit] )
+
+      [object, [unit, _sources]]
+    end
+  end
+
 end
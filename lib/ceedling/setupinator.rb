@@ -35,6 +35,9 @@ class Setupinator
     @plugin_manager       = value[:plugin_manager]
     @plugin_reportinator  = value[:plugin_reportinator]
     @test_runner_manager  = value[:test_runner_manager]
+    @progress_renderer    = value[:progress_renderer]
+    @profiler             = value[:profiler]
+    @explainer            = value[:explainer]
   end
 
 
@@ -54,9 +57,18 @@ class Setupinator
     @configurator.set_verbosity( config_hash )
 
     # Logging configuration
-    @loginator.set_logfile( app_cfg[:log_filepath] )
+    @loginator.set_logfile( app_cfg[:log_filepath], app_cfg[:log_format] )
     @configurator.project_logging = @loginator.project_logging
 
+    # Compact progress display (if requested and possible)
+    @progress_renderer.enable() if app_cfg[:progress]
+
+    # Build profiling (if requested)
+    @profiler.enable( app_cfg[:logging_path] ) if app_cfg[:profile]
+
+    # Test build explanations (if requested)
+    @explainer.enable( app_cfg[:logging_path] ) if app_cfg[:explain]
+
     log_step( 'Validating configuration contains minimum required sections', heading: false )
 
     # Complain early about anything essential that's missing
@@ -10,6 +10,51 @@ require 'open3'
 
 class SystemWrapper
 
+  # Read size for streamed process output
+  STREAM_CHUNK_BYTES = 16384
+
+  # Bytes retained from the end of a bounded output stream (statistics, crash messages, etc.)
+  STREAM_TAIL_BYTES = 65536
+
+  # Bounded capture of a process output stream: head bytes up to a limit plus a rolling tail
+  class StreamExcerpt
+    def initialize(limit)
+      @limit = limit
+      @head = ''.b
+      @tail = ''.b
+      @omitted = 0
+    end
+
+    def <<(chunk)
+      chunk = chunk.b
+
+      if @limit.nil? or (@head.bytesize + chunk.bytesize <= @limit)
+        @head << chunk
+        return
+      end
+
+      if @head.bytesize < @limit
+        room = @limit - @head.bytesize
+        @head << chunk.byteslice( 0, room )
+        chunk = chunk.byteslice( room..-1 )
+      end
+
+      @tail << chunk
+      if @tail.bytesize > STREAM_TAIL_BYTES
+        excess = @tail.bytesize - STREAM_TAIL_BYTES
+        @omitted += excess
+        @tail = @tail.byteslice( excess..-1 )
+      end
+    end
+
+    def to_s
+      excerpt = @head.dup
+      excerpt << "\n[... #{@omitted} bytes of output omitted ...]\n" if @omitted > 0
+      excerpt << @tail
+      return excerpt.force_encoding( Encoding::UTF_8 )
+    end
+  end
+
   # Memoized: host_os is fixed for the process lifetime.
   # Guard against nil? rather than ||= so false (non-Windows) is cached correctly.
   def self.windows?
@@ -63,14 +108,16 @@ class SystemWrapper
 
   # If set, `boom` allows a non-zero exit code in results.
   # Otherwise, disabled `boom` forces a success exit code but collects errors.
-  def shell_capture3(command:, boom:false) 
+  # `chdir` and `env` run the command in a working directory and with environment
+  # variables of its own without changing those of the Ceedling process (thread-safe).
+  def shell_capture3(command:, boom:false, chdir:nil, env:{}) 
     # Beginning with later versions of Ruby2, simple exit codes were replaced
     # by the more capable and robust Process::Status.
     # Parts of Process::Status's behavior is similar to an integer exit code in
     # some operations but not all.
     exit_code = 0
     
-    stdout, stderr, status = Open3.capture3(command)
+    stdout, stderr, status = Open3.capture3( env, command, **spawn_options( chdir ) )
 
     # If boom, then capture the actual exit code.
     # Otherwise, leave it as zero as though execution succeeded.
@@ -95,6 +142,58 @@ class SystemWrapper
     }
   end
 
+  # Like `shell_capture3()` but yields (:stdout | :stderr, chunk) as output arrives.
+  # If `limit` is set, the returned output retains only the first `limit` bytes and
+  # the final `STREAM_TAIL_BYTES` bytes of each stream; the middle is marked omitted.
+  def shell_stream(command:, boom:false, limit:nil, chdir:nil, env:{})
+    exit_code = 0
+
+    excerpts = {
+      stdout: StreamExcerpt.new( limit ),
+      stderr: StreamExcerpt.new( limit )
+    }
+
+    status = nil
+
+    Open3.popen3( env, command, **spawn_options( chdir ) ) do |stdin, stdout, stderr, thread|
+      stdin.close()
+
+      streams = { stdout => :stdout, stderr => :stderr }
+
+      while !streams.empty?
+        ready, _, _ = IO.select( streams.keys )
+        ready.each do |io|
+          begin
+            chunk = io.read_nonblock( STREAM_CHUNK_BYTES )
+            excerpts[streams[io]] << chunk
+            yield( streams[io], chunk ) if block_given?
+          rescue IO::WaitReadable
+            # Spurious wakeup; select again
+          rescue EOFError
+            streams.delete( io )
+          end
+        end
+      end
+
+      status = thread.value
+    end
+
+    stdout = excerpts[:stdout].to_s
+    stderr = excerpts[:stderr].to_s
+
+    exit_code = status.exitstatus.freeze if boom and !status.nil?
+
+    $exit_code = exit_code if exit_code != 0
+
+    return {
+      output: (stdout + stderr).freeze,
+      stdout: stdout.freeze,
+      stderr: stderr.freeze,
+      status: status.freeze,
+      exit_code: exit_code.freeze
+    }
+  end
+
   def shell_backticks(command:, boom:false)
     output = `#{command}`.freeze
     $exit_code = ($?.exitstatus).freeze if boom
@@ -144,4 +243,12 @@ class SystemWrapper
     return Object.constants.map{|constant| constant.to_s}.include?(item.to_s)
   end
 
+  ### Private ###
+
+  private
+
+  def spawn_options(chdir)
+    return chdir.nil? ? {} : { :chdir => chdir }
+  end
+
 end
@@ -263,8 +263,36 @@ class TestContextExtractor
     return _includes
   end
 
+  # Everything collected for a test file, for reuse by a later build of the same test in another context
+  def snapshot_context(filepath)
+    key = form_file_key( filepath )
+
+    @lock.synchronize do
+      return per_file_lookups().map { |lookup| [lookup, instance_variable_get( lookup )[key]] }.to_h
+    end
+  end
+
+  # Replace whatever has since been collected for a test file with a snapshot from `snapshot_context()`
+  # (e.g. one taken by a worker process)
+  def restore_context(filepath, snapshot)
+    key = form_file_key( filepath )
+
+    @lock.synchronize do
+      snapshot.each do |lookup, value|
+        hash = instance_variable_get( lookup )
+        value.nil? ? hash.delete( key ) : (hash[key] = value)
+      end
+
+      @all_include_paths |= (snapshot[:@include_paths] || [])
+    end
+  end
+
   private #################################
 
+  def per_file_lookups()
+    return [:@header_includes, :@source_includes, :@source_extras, :@test_runner_details, :@partials_config, :@include_paths]
+  end
+
   def collect_build_directive_source_files(filepath, files)
     _files = files.compact
     _files.uniq!
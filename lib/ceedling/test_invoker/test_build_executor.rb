@@ -7,6 +7,7 @@
 
 require 'ceedling/constants'
 require 'ceedling/exceptions'
+require 'ceedling/dependency_graph'
 require 'ceedling/test_invoker/test_invoker_types'
 
 class TestBuildExecutor
@@ -25,7 +26,9 @@ class TestBuildExecutor
     :plugin_manager,
     :file_path_utils,
     :file_finder,
-    :file_wrapper
+    :file_wrapper,
+    :include_pathinator,
+    :explainer
   )
 
   def setup()
@@ -36,61 +39,8 @@ class TestBuildExecutor
   def stage_preprocess_partial_headers(state)
     directives_only = @configurator.test_build_preprocess_directives_only_available
 
-    # Generate directive-only preprocessor output if available
-    @batchinator.exec(workload: :compile, things: state.partials_headers) do |details|
-      config   = details[:config]
-      testable = details[:testable]
-      name     = testable.name
-
-      arg_hash = {
-        filepath:      config.filepath,
-        test:          name,
-        flags:         testable.preprocess_flags,
-        include_paths: testable.search_paths,
-        vendor_paths:  [@configurator.project_build_vendor_ceedling_path],
-        defines:       testable.preprocess_defines
-      }
-
-      details[:directives_only_filepath] = @preprocessinator.generate_directives_only_output( **arg_hash )
-    end if directives_only
-
-    # Preprocess and assemble header files
-    @batchinator.exec(workload: :compile, things: state.partials_headers) do |details|
-      config                   = details[:config]
-      testable                 = details[:testable]
-      name                     = testable.name
-      directives_only_filepath = details[:directives_only_filepath]
-
-      arg_hash = {
-        test:                     name,
-        filepath:                 config.filepath,
-        directives_only_filepath: directives_only_filepath,
-        fallback:                 (!directives_only or directives_only_filepath.nil?),
-        flags:                    testable.preprocess_flags,
-        include_paths:            testable.search_paths,
-        vendor_paths:             [@configurator.project_build_vendor_ceedling_path],
-        defines:                  testable.preprocess_defines
-      }
-
-      config.directives_only_filepath, config.includes = @preprocessinator.preprocess_partial_header_file_preserve_macros( **arg_hash )
-    end
-
-    # Full-preprocess partial header files for expanded signature extraction.
     @batchinator.exec(workload: :compile, things: state.partials_headers) do |details|
-      config   = details[:config]
-      testable = details[:testable]
-      name     = testable.name
-
-      arg_hash = {
-        filepath:      config.filepath,
-        test:          name,
-        flags:         testable.preprocess_flags,
-        include_paths: testable.search_paths,
-        vendor_paths:  [@configurator.project_build_vendor_ceedling_path],
-        defines:       testable.preprocess_defines
-      }
-
-      config.full_expansion_filepath = @preprocessinator.preprocess_partial_header_expand_macros( **arg_hash )
+      preprocess_partial_file( details: details, directives_only: directives_only, type: :header )
     end
   end
 
@@ -98,171 +48,43 @@ class TestBuildExecutor
   def stage_preprocess_partial_sources(state)
     directives_only = @configurator.test_build_preprocess_directives_only_available
 
-    # Generate directive-only preprocessor output if available
-    @batchinator.exec(workload: :compile, things: state.partials_sources) do |details|
-      config   = details[:config]
-      testable = details[:testable]
-      name     = testable.name
-
-      arg_hash = {
-        filepath:      config.filepath,
-        test:          name,
-        flags:         testable.preprocess_flags,
-        include_paths: testable.search_paths,
-        vendor_paths:  [@configurator.project_build_vendor_ceedling_path],
-        defines:       testable.preprocess_defines
-      }
-
-      details[:directives_only_filepath] = @preprocessinator.generate_directives_only_output( **arg_hash )
-    end if directives_only
-
-    # Preprocess and assemble source files
-    @batchinator.exec(workload: :compile, things: state.partials_sources) do |details|
-      config                   = details[:config]
-      testable                 = details[:testable]
-      name                     = testable.name
-      directives_only_filepath = details[:directives_only_filepath]
-
-      arg_hash = {
-        test:                     name,
-        filepath:                 config.filepath,
-        directives_only_filepath: directives_only_filepath,
-        fallback:                 (!directives_only or directives_only_filepath.nil?),
-        flags:                    testable.preprocess_flags,
-        include_paths:            testable.search_paths,
-        vendor_paths:             [@configurator.project_build_vendor_ceedling_path],
-        defines:                  testable.preprocess_defines
-      }
-
-      config.directives_only_filepath, config.includes = @preprocessinator.preprocess_partial_source_file_preserve_macros( **arg_hash )
-    end
-
-    # Full-preprocess partial source files for expanded signature extraction.
     @batchinator.exec(workload: :compile, things: state.partials_sources) do |details|
-      config   = details[:config]
-      testable = details[:testable]
-      name     = testable.name
-
-      arg_hash = {
-        filepath:      config.filepath,
-        test:          name,
-        flags:         testable.preprocess_flags,
-        include_paths: testable.search_paths,
-        vendor_paths:  [@configurator.project_build_vendor_ceedling_path],
-        defines:       testable.preprocess_defines
-      }
-
-      config.full_expansion_filepath = @preprocessinator.preprocess_partial_source_expand_macros( **arg_hash )
+      preprocess_partial_file( details: details, directives_only: directives_only, type: :source )
     end
   end
 
   # Stage 8: Extract and generate partial implementation and interface files.
+  # Ruby-bound (C extraction) -- each item returns the modules it generated for merging here.
   def stage_generate_partials(state)
-    directives_only = @configurator.test_build_preprocess_directives_only_available
-
     partials = []
     state.testables.each do |_, testable|
+      next if testable.shared
       next if testable.partials.configs.empty?
       testable.partials.configs.each do |_, config|
         partials << { config: config, testable: testable }
       end
     end
 
-    @batchinator.exec(workload: :compile, things: partials) do |partial|
-      config   = partial[:config]
-      testable = partial[:testable]
-      name     = testable.name
-
-      module_contents = @partializer.extract_module_contents(
-        name,
-        config,
-        !directives_only
-      )
-
-      @partializer.validate_config( c_module: module_contents, config: config, name: name )
-
-      @partializer.sanitize( module_contents )
-
-      # Generated once and shared by the implementation and interface headers below (via
-      # their own includes lists), so a module tested and mocked in the same test file gets
-      # exactly one C definition of each of its typedefs and aggregate types.
-      types_header = @generator.generate_partial_types(
-        name:        config.module, # Module name, not test name -- two modules Partialed
-                                     # in the same test file must not collide on one
-                                     # shared types header filename
-        c_module:    module_contents,
-        output_path: testable.paths[:partials]
-      )
-
-      implementation = @partializer.extract_implementation_functions(
-        test:        name,
-        partial:     config.module,
-        definitions: module_contents.function_definitions,
-        config:      config
-      )
-
-      interface = @partializer.extract_interface_functions(
-        test:         name,
-        partial:      config.module,
-        definitions:  module_contents.function_definitions,
-        declarations: module_contents.function_declarations,
-        config:       config
-      )
-
-      @partializer.validate_extracted_functions(
-        name:      name,
-        partial:   config.module,
-        impl:      implementation,
-        interface: interface
-      )
-
-      arg_hash = {
-        test:                 name,
-        partial:              config.module,
-        function_definitions: implementation,
-        c_module:             module_contents,
-        header_includes:      @partializer.remap_implementation_header_includes(
-                                name:         config.module,
-                                includes:     (config.source.includes + config.header.includes),
-                                partials:     testable.partials.configs,
-                                types_header: types_header,
-                                test:         name
-                              ),
-        source_includes:      @partializer.remap_implementation_source_includes(
-                                name:     config.module,
-                                includes: (config.source.includes + config.header.includes),
-                                partials: testable.partials.configs,
-                                test:     name
-                              ),
-        input_filepath:       config.source.filepath,
-        output_path:          testable.paths[:partials]
-      }
+    if @configurator.project_ruby_workers == :processes
+      # Each worker process keeps its own cache of extracted modules (see Partializer). All the
+      # tests Partialing the same module go to one worker together so it extracts the module once.
+      batches = partials.group_by {|partial| [partial[:config].source.filepath, partial[:config].header.filepath] }.values
+      batches.map! {|batch| {name: batch.first[:config].module, partials: batch} }
 
-      unless implementation.nil?
-        @generator.generate_partial_implementation( **arg_hash )
-        state.lock.synchronize { testable.partials.tests << config.module }
+      generated = @batchinator.exec(workload: :ruby, things: batches) do |batch|
+        batch[:partials].map {|partial| generate_partial( **partial ) }
       end
 
-      arg_hash = {
-        test:                  name,
-        partial:               config.module,
-        function_declarations: interface,
-        includes:              @partializer.remap_interface_header_includes(
-                                 name:         config.module,
-                                 includes:     (config.source.includes + config.header.includes),
-                                 partials:     testable.partials.configs,
-                                 types_header: types_header,
-                                 test:         name
-                               ),
-        c_module:              module_contents,
-        input_filepath:        config.header.filepath,
-        output_path:           testable.paths[:partials]
-      }
+      partials = batches.flat_map {|batch| batch[:partials] }
+      generated = generated.flatten( 1 )
+    else
+      generated = @batchinator.exec(workload: :ruby, things: partials) {|partial| generate_partial( **partial ) }
+    end
 
-      unless interface.nil?
-        @generator.generate_partial_interface( **arg_hash )
-        state.lock.synchronize { testable.partials.mocks << config.module }
-      end
+    partials.zip( generated ).each do |partial, modules|
+      testable = partial[:testable]
+      testable.partials.tests << modules[:tests] unless modules[:tests].nil?
+      testable.partials.mocks << modules[:mocks] unless modules[:mocks].nil?
     end
   end
 
@@ -320,9 +142,9 @@ class TestBuildExecutor
     end
   end
 
-  # Stage 10: Generate mocks for all tests.
+  # Stage 10: Generate mocks for all tests (Ruby-bound -- CMock).
   def stage_generate_mocks(state)
-    @batchinator.exec(workload: :compile, things: state.mocks_list) do |mock|
+    @batchinator.exec(workload: :ruby, things: state.mocks_list) do |mock|
       details  = mock[:details]
       testable = mock[:testable]
 
@@ -337,7 +159,15 @@ class TestBuildExecutor
         output_path:    output_path
       }
 
-      @generator.generate_mock( **arg_hash )
+      outputs = [@configurator.extension_header, @configurator.extension_source].map do |extension|
+        File.join( output_path, details[:name] + extension )
+      end
+
+      @explainer.artifact( :mocks, test: testable.name, outputs: outputs, inputs: [details[:source]] ) do
+        @generator.generate_mock( **arg_hash )
+      end
+
+      nil # Mocks are files -- nothing to return from a worker process
     end
   end
 
@@ -346,6 +176,8 @@ class TestBuildExecutor
     directives_only = @configurator.test_build_preprocess_directives_only_available
 
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      next if testable.shared
+
       filepath                 = testable.filepath
       filename                 = File.basename( filepath )
       name                     = testable.name
@@ -393,6 +225,8 @@ class TestBuildExecutor
   # Stage 12: Collect test runner details (test case names) from preprocessed test files.
   def stage_collect_runner_details(state)
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      next if testable.shared
+
       msg = @reportinator.generate_module_progress(
         operation:   'Parsing test case names',
         module_name: testable.name,
@@ -404,9 +238,11 @@ class TestBuildExecutor
     end
   end
 
-  # Stage 13: Generate test runner files.
+  # Stage 13: Generate test runner files (Ruby-bound).
   def stage_generate_runners(state)
-    @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+    @batchinator.exec(workload: :ruby, things: state.testables) do |_, testable|
+      next if testable.shared
+
       arg_hash = {
         context:         state.context,
         mocks:           @context_extractor.lookup_mock_header_includes_list( testable.filepath ),
@@ -416,22 +252,37 @@ class TestBuildExecutor
         runner_filepath: testable.runner[:output_filepath]
       }
 
-      @generator.generate_test_runner( **arg_hash )
+      @explainer.artifact( :runner, test: testable.name, outputs: [testable.runner[:output_filepath]], inputs: [testable.filepath] ) do
+        @generator.generate_test_runner( **arg_hash )
+      end
+
+      nil # Runners are files -- nothing to return from a worker process
     end
   end
 
   # Stage 15: Compile all test build objects in parallel.
   def stage_build_objects(state)
+    load_minimal_search_paths( state ) if @configurator.test_build_minimal_search_paths
+
     @batchinator.exec(workload: :compile, things: state.objects_list) do |obj|
-      src = @file_finder.find_build_input_file( filepath: obj[:obj], context: state.context )
-      compile_test_component(
-        context: state.context,
-        test:    obj[:test],
-        source:  src,
-        object:  obj[:obj],
-        state:   state
-      )
+      # Jumbo build units are generated in the test's build path, not found among build input
+      src = state.testables[obj[:test].to_sym].jumbo[obj[:obj]] ||
+            @file_finder.find_build_input_file( filepath: obj[:obj], context: state.context )
+
+      inputs = object_inputs( context: state.context, test: obj[:test], source: src, object: obj[:obj] )
+
+      @explainer.artifact( :objects, test: obj[:test], outputs: [obj[:obj]], inputs: inputs ) do
+        compile_test_component(
+          context: state.context,
+          test:    obj[:test],
+          source:  src,
+          object:  obj[:obj],
+          state:   state
+        )
+      end
     end
+
+    record_minimal_search_paths( state ) if @configurator.test_build_minimal_search_paths
   end
 
   # Stage 16: Link test executables.
@@ -453,7 +304,9 @@ class TestBuildExecutor
         options:    state.options
       }
 
-      generate_executable_now( **arg_hash )
+      @explainer.artifact( :link, test: testable.name, outputs: [testable.executable], inputs: testable.objects ) do
+        generate_executable_now( **arg_hash )
+      end
     end
   end
 
@@ -470,7 +323,12 @@ class TestBuildExecutor
           options:       state.options
         }
 
-        run_fixture_now( **arg_hash )
+        # Results of the previous run are in a pass or a fail results file
+        results = [testable.results_pass, testable.results_fail].find {|filepath| @file_wrapper.exist?( filepath )}
+
+        @explainer.artifact( :run, test: testable.name, outputs: [results || testable.results_pass], inputs: [testable.executable] ) do
+          run_fixture_now( **arg_hash )
+        end
 
       ensure
         @plugin_manager.post_test( testable.filepath )
@@ -557,11 +415,166 @@ class TestBuildExecutor
 
   private
 
-  # Compile a single C or assembly source file into an object file.
+  # Extract and generate the implementation and interface files of one Partial of a test.
+  # Returns the modules generated (see `stage_generate_partials`).
+  def generate_partial(config:, testable:)
+    directives_only = @configurator.test_build_preprocess_directives_only_available
+    name = testable.name
+
+    module_contents = @partializer.extract_module_contents(
+      name,
+      config,
+      !directives_only
+    )
+
+    @partializer.validate_config( c_module: module_contents, config: config, name: name )
+
+    @partializer.sanitize( module_contents )
+
+    # Generated once and shared by the implementation and interface headers below (via
+    # their own includes lists), so a module tested and mocked in the same test file gets
+    # exactly one C definition of each of its typedefs and aggregate types.
+    types_header = @generator.generate_partial_types(
+      name:        config.module, # Module name, not test name -- two modules Partialed
+                                   # in the same test file must not collide on one
+                                   # shared types header filename
+      c_module:    module_contents,
+      output_path: testable.paths[:partials]
+    )
+
+    implementation = @partializer.extract_implementation_functions(
+      test:        name,
+      partial:     config.module,
+      definitions: module_contents.function_definitions,
+      config:      config
+    )
+
+    interface = @partializer.extract_interface_functions(
+      test:         name,
+      partial:      config.module,
+      definitions:  module_contents.function_definitions,
+      declarations: module_contents.function_declarations,
+      config:       config
+    )
+
+    @partializer.validate_extracted_functions(
+      name:      name,
+      partial:   config.module,
+      impl:      implementation,
+      interface: interface
+    )
+
+    arg_hash = {
+      test:                 name,
+      partial:              config.module,
+      function_definitions: implementation,
+      c_module:             module_contents,
+      header_includes:      @partializer.remap_implementation_header_includes(
+                              name:         config.module,
+                              includes:     (config.source.includes + config.header.includes),
+                              partials:     testable.partials.configs,
+                              types_header: types_header,
+                              test:         name
+                            ),
+      source_includes:      @partializer.remap_implementation_source_includes(
+                              name:     config.module,
+                              includes: (config.source.includes + config.header.includes),
+                              partials: testable.partials.configs,
+                              test:     name
+                            ),
+      input_filepath:       config.source.filepath,
+      output_path:          testable.paths[:partials]
+    }
+
+    unless implementation.nil?
+      @generator.generate_partial_implementation( **arg_hash )
+    end
+
+    arg_hash = {
+      test:                  name,
+      partial:               config.module,
+      function_declarations: interface,
+      includes:              @partializer.remap_interface_header_includes(
+                               name:         config.module,
+                               includes:     (config.source.includes + config.header.includes),
+                               partials:     testable.partials.configs,
+                               types_header: types_header,
+                               test:         name
+                             ),
+      c_module:              module_contents,
+      input_filepath:        config.header.filepath,
+      output_path:           testable.paths[:partials]
+    }
+
+    unless interface.nil?
+      @generator.generate_partial_interface( **arg_hash )
+    end
+
+    { tests: (config.module unless implementation.nil?), mocks: (config.module unless interface.nil?) }
+  end
+
+  # All preprocessing of one Partial header or source file (`type` of :header or :source) as
+  # a single job so that a slow file delays only its own follow-on passes:
+  #  1. Directive-only preprocessor output (if available)
+  #  2. Reconstituted file preserving macros and discovery of its #includes
+  #  3. Full preprocessing for expanded signature extraction
+  def preprocess_partial_file(details:, directives_only:, type:)
+    config   = details[:config]
+    testable = details[:testable]
+    name     = testable.name
+
+    arg_hash = {
+      filepath:      config.filepath,
+      test:          name,
+      flags:         testable.preprocess_flags,
+      include_paths: testable.search_paths,
+      vendor_paths:  [@configurator.project_build_vendor_ceedling_path],
+      defines:       testable.preprocess_defines
+    }
+
+    directives_only_filepath = nil
+    directives_only_filepath = @preprocessinator.generate_directives_only_output( **arg_hash ) if directives_only
+
+    preserve_macros_arg_hash = arg_hash.merge(
+      directives_only_filepath: directives_only_filepath,
+      fallback:                 (!directives_only or directives_only_filepath.nil?)
+    )
+
+    if type == :header
+      config.directives_only_filepath, config.includes = @preprocessinator.preprocess_partial_header_file_preserve_macros( **preserve_macros_arg_hash )
+      config.full_expansion_filepath = @preprocessinator.preprocess_partial_header_expand_macros( **arg_hash )
+    else
+      config.directives_only_filepath, config.includes = @preprocessinator.preprocess_partial_source_file_preserve_macros( **preserve_macros_arg_hash )
+      config.full_expansion_filepath = @preprocessinator.preprocess_partial_source_expand_macros( **arg_hash )
+    end
+  end
+
+  # Compile a single C or assembly source file into an object file -- with a test's minimal
+  # search paths if known. A failure with minimal search paths discards them and is retried with all.
   def compile_test_component(context:, test:, source:, object:, state:)
-    testable     = state.testables[test.to_sym]
+    testable = state.testables[test.to_sym]
+    minimal  = testable.minimal_search_paths
+
+    arg_hash = { context: context, test: test, source: source, object: object, testable: testable }
+
+    begin
+      generate_test_object( search_paths: (minimal || testable.search_paths), **arg_hash )
+    rescue ShellException => ex
+      raise ex if minimal.nil?
+
+      # Should the retry also fail, the next build starts from all search paths
+      @file_wrapper.rm_f( @file_path_utils.form_test_search_paths_cache_filepath( testable.name, context: context ) )
+
+      msg = "Compiling #{File.basename( source )} with minimal search paths failed. Retrying with all search paths..."
+      @loginator.log( msg, Verbosity::NORMAL, LogLabels::NOTICE )
+
+      generate_test_object( search_paths: testable.search_paths, **arg_hash )
+    end
+  end
+
+  def generate_test_object(context:, test:, source:, object:, testable:, search_paths:)
     defines      = testable.compile_defines
-    search_paths = tailor_search_paths( search_paths: testable.search_paths, filepath: source )
+    search_paths = tailor_search_paths( search_paths: search_paths, filepath: source )
 
     if @file_wrapper.extname( source ) != @configurator.extension_assembly
       flags = testable.compile_flags
@@ -601,6 +614,67 @@ class TestBuildExecutor
     end
   end
 
+  # Files an object was built from according to the dependencies file of its previous build
+  # (only needed for explanations)
+  def object_inputs(context:, test:, source:, object:)
+    return [] if !@explainer.enabled?
+
+    filepath = @file_path_utils.form_test_dependencies_filepath( object, name: test, context: context )
+    return [source] if !@file_wrapper.exist?( filepath )
+
+    return ([source] + DependencyGraph.parse_paths( @file_wrapper.read( filepath ) )).uniq
+  end
+
+  # Minimal search paths recorded by the previous build of each test (if still applicable)
+  def load_minimal_search_paths(state)
+    @include_pathinator.forget_file_digests()
+
+    @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      testable.minimal_search_paths = @include_pathinator.load_minimal_search_paths(
+        search_paths: testable.search_paths,
+        defines:      testable.compile_defines,
+        flags:        compilation_flags( testable ),
+        filepath:     @file_path_utils.form_test_search_paths_cache_filepath( testable.name, context: state.context )
+      )
+    end
+  end
+
+  # Minimal search paths of each test found from the dependencies files of its freshly built objects
+  def record_minimal_search_paths(state)
+    @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      filepath = @file_path_utils.form_test_search_paths_cache_filepath( testable.name, context: state.context )
+
+      dependencies = testable.objects.map do |object|
+        @file_path_utils.form_test_dependencies_filepath( object, name: testable.name, context: state.context )
+      end
+
+      minimal = @include_pathinator.minimize_search_paths( search_paths: testable.search_paths, dependencies: dependencies )
+
+      if minimal.nil?
+        @file_wrapper.rm_f( filepath )
+        next
+      end
+
+      @loginator.lazy( Verbosity::DEBUG ) do
+        "Minimal search paths for #{testable.name}: #{minimal.size} of #{testable.search_paths.size}"
+      end
+
+      @include_pathinator.store_minimal_search_paths(
+        search_paths: testable.search_paths,
+        defines:      testable.compile_defines,
+        flags:        compilation_flags( testable ),
+        minimal:      minimal,
+        dependencies: dependencies,
+        filepath:     filepath
+      )
+    end
+  end
+
+  # Flags of every kind of compilation of a test's objects (see `generate_test_object`)
+  def compilation_flags(testable)
+    return testable.compile_flags.to_a + testable.assembler_flags.to_a
+  end
+
   def tailor_search_paths(filepath:, search_paths:)
     _search_paths = []
 
@@ -19,6 +19,7 @@ class TestBuildPlanner
     :batchinator,
     :test_context_extractor,
     :partializer,
+    :jumbo_builder,
     :file_finder,
     :file_path_utils,
     :file_wrapper,
@@ -27,6 +28,34 @@ class TestBuildPlanner
 
   def setup()
     @context_extractor = @test_context_extractor
+
+    # Context-independent artifacts (preprocessing, mocks, partials, runners) by test filepath.
+    # Kept for the life of the process so a later build in another context (e.g. :gcov after :test)
+    # can reuse what an earlier build generated rather than generating it again.
+    @shared_artifacts = {}
+  end
+
+  # Transform T1: Mark tests whose context-independent artifacts an earlier build already generated.
+  # Only objects, executables, and results differ between contexts unless preprocessing inputs do.
+  def stage_identify_shared_artifacts(state)
+    state.testables.each do |_, testable|
+      shared = @shared_artifacts[testable.filepath]
+
+      next if shared.nil?
+      next if shared[:inputs] != shared_artifact_inputs( testable )
+      next if !@file_wrapper.exist?( shared[:runner][:output_filepath] )
+
+      testable.shared     = true
+      testable.preprocess = shared[:preprocess]
+      @context_extractor.restore_context( testable.filepath, shared[:context] )
+
+      msg = @reportinator.generate_module_progress(
+        operation:   "Reusing preprocessing, mocks & runner from :#{shared[:build]} build for",
+        module_name: testable.name,
+        filename:    File.basename( testable.filepath )
+      )
+      @loginator.log( msg )
+    end
   end
 
   # Stage 5: Determine runners, mocks, and partials for all tests.
@@ -81,9 +110,23 @@ class TestBuildPlanner
     end
   end
 
-  # Transform T1: Flatten partials into parallel-processing-friendly lists.
+  # Transform T2: Restore the runner and Partials details of tests reusing shared artifacts.
+  def stage_restore_shared_artifacts(state)
+    state.testables.each do |_, testable|
+      next unless testable.shared
+
+      shared = @shared_artifacts[testable.filepath]
+
+      testable.runner         = shared[:runner].dup
+      testable.partials.tests = shared[:partials_tests].dup
+      testable.partials.mocks = shared[:partials_mocks].dup
+    end
+  end
+
+  # Transform T3: Flatten partials into parallel-processing-friendly lists.
   def stage_flatten_partials_lists(state)
     state.testables.each do |_, testable|
+      next if testable.shared
       testable.partials.configs.each do |_, config|
         state.partials_headers << {
           config:                   config.header,
@@ -100,9 +143,10 @@ class TestBuildPlanner
     end
   end
 
-  # Transform T2: Flatten mocks into a parallel-processing-friendly list.
+  # Transform T4: Flatten mocks into a parallel-processing-friendly list.
   def stage_flatten_mocks_list(state)
     state.testables.each do |_, testable|
+      next if testable.shared
       testable.mocks.each do |name, elems|
         state.mocks_list << {
           name:                     name,
@@ -114,6 +158,23 @@ class TestBuildPlanner
     end
   end
 
+  # Transform T5: Record context-independent artifacts for reuse by builds in other contexts.
+  def stage_record_shared_artifacts(state)
+    state.testables.each do |_, testable|
+      next if testable.shared
+
+      @shared_artifacts[testable.filepath] = {
+        build:          state.context,
+        inputs:         shared_artifact_inputs( testable ),
+        preprocess:     testable.preprocess,
+        runner:         testable.runner.dup,
+        partials_tests: testable.partials.tests.dup,
+        partials_mocks: testable.partials.mocks.dup,
+        context:        @context_extractor.snapshot_context( testable.filepath )
+      }
+    end
+  end
+
   # Stage 14: Determine the full set of objects to compile and link for each test.
   def stage_determine_artifacts(state)
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
@@ -153,11 +214,22 @@ class TestBuildPlanner
 
       test_objects = (test_objects.uniq - test_no_link_objects)
 
+      # Jumbo build unit object => [unit source, sources it combines]
+      units = generate_jumbo_units(
+        context:    state.context,
+        build_path: testable.paths[:build],
+        sources:    test_sources,
+        objects:    test_objects
+      )
+      units.each {|_, (_, sources)| test_objects -= @file_path_utils.form_test_build_objects_filelist( testable.paths[:build], sources )}
+      test_objects += units.keys
+
       state.lock.synchronize do
         testable.sources         = test_sources
         testable.frameworks      = test_frameworks
         testable.core            = test_core
         testable.objects         = test_objects
+        testable.jumbo           = units.transform_values {|(unit, _)| unit}
         testable.executable      = test_executable
         testable.no_link_objects = test_no_link_objects
         testable.results_pass    = test_pass
@@ -166,7 +238,7 @@ class TestBuildPlanner
     end
   end
 
-  # Transform T3: Flatten testable objects into a parallel-processing-friendly list.
+  # Transform T6: Flatten testable objects into a parallel-processing-friendly list.
   def stage_flatten_objects_list(state)
     state.objects_list = state.testables.map do |_, testable|
       testable.objects.map do |obj|
@@ -182,6 +254,35 @@ class TestBuildPlanner
   # Helper methods
   # -----------------------------------------------------------------------
 
+  # Everything that shapes preprocessing output and therefore mocks, Partials, and runners.
+  # Compilation flags & defines are not included -- they only affect objects.
+  def shared_artifact_inputs(testable)
+    return [testable.search_paths, testable.preprocess_flags, testable.preprocess_defines]
+  end
+
+  # Only a test's production sources are combined (never the test, mocks, runner, or
+  # frameworks) and only for plain test builds -- coverage and other plugin contexts
+  # compile each source on its own to keep per-source results
+  def generate_jumbo_units(context:, build_path:, sources:, objects:)
+    size = @configurator.test_build_jumbo_size
+    return {} if (context != TEST_SYM) or (size < 2)
+
+    # Sources excluded from linking (e.g. a header's counterpart built by the test itself) stay out
+    sources = sources.select do |source|
+      objects.include?( @file_path_utils.form_test_build_objects_filelist( build_path, [source] )[0] )
+    end
+
+    units = @jumbo_builder.generate(
+      sources:    @jumbo_builder.eligible( sources, exclude: @configurator.test_build_jumbo_exclude ),
+      size:       size,
+      build_path: build_path
+    )
+
+    return units.to_h do |unit, _sources|
+      [@file_path_utils.form_test_build_objects_filelist( build_path, [unit] )[0], [unit, _sources]]
+    end
+  end
+
   def assemble_partials_config(filepath:)
     configs = @test_context_extractor.lookup_partials_config( filepath )
     return @partializer.populate_filepaths( configs )
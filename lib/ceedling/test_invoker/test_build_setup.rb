@@ -89,8 +89,9 @@ class TestBuildSetup
   end
 
   # Stage 2: Collect includes, build directives, and test case context from each test file.
+  # Ruby-bound (parsing) -- each item returns the context it collected for merging here.
   def stage_collect_test_context(state)
-    @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+    collected = @batchinator.exec(workload: :ruby, things: state.testables) do |_, testable|
       filepath = testable.filepath
       filename = File.basename( filepath )
 
@@ -132,6 +133,12 @@ class TestBuildSetup
         partials_in_use: !(@context_extractor.lookup_partials_config( filepath )).empty?,
         includes:        @context_extractor.lookup_all_header_includes_list( filepath )
       )
+
+      @context_extractor.snapshot_context( filepath )
+    end
+
+    state.testables.each_value.zip( collected ) do |testable, context|
+      @context_extractor.restore_context( testable.filepath, context )
     end
 
     process_project_include_paths()
@@ -176,6 +183,8 @@ class TestBuildSetup
   def stage_collect_preprocessor_context(state)
     # First pass: extract bare includes; create stand-in files for mocks and partials
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      next if testable.shared
+
       name     = testable.name
       filepath = testable.filepath
 
@@ -215,6 +224,7 @@ class TestBuildSetup
     directives_only = @configurator.test_build_preprocess_directives_only_available
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
       next unless directives_only
+      next if testable.shared
 
       name     = testable.name
       filepath = testable.filepath
@@ -242,6 +252,8 @@ class TestBuildSetup
     # Third pass: reconcile includes from all extraction sources and ingest
     directives_only = @configurator.test_build_preprocess_directives_only_available
     @batchinator.exec(workload: :compile, things: state.testables) do |_, testable|
+      next if testable.shared
+
       filepath = testable.filepath
       filename = File.basename( filepath )
       name     = testable.name
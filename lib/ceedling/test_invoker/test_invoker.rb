@@ -25,7 +25,9 @@ class TestInvoker
     :plugin_manager,
     :batchinator,
     :loginator,
-    :verbosinator
+    :verbosinator,
+    :profiler,
+    :explainer
   )
 
   def setup
@@ -103,9 +105,19 @@ class TestInvoker
       if stage.transform
         stage.body.call( state )
       else
-        @batchinator.build_step( stage.name, heading: stage.heading ) do
-          stage.body.call( state )
+        started = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+
+        @profiler.span( stage.name, category: :stage, args: {:context => state.context} ) do
+          @explainer.stage( stage.name, node: stage.node, context: state.context ) do
+            @batchinator.build_step( stage.name, heading: stage.heading ) do
+              stage.body.call( state )
+            end
+          end
         end
+
+        # Stage timings for build analysis and benchmarking (structured logs only)
+        duration = Process.clock_gettime( Process::CLOCK_MONOTONIC ) - started
+        @loginator.event( :stage, {:name => stage.name, :context => state.context, :duration => duration.round( 6 )} )
       end
     end
   end
@@ -127,16 +139,25 @@ class TestInvoker
 
       # Stage 2
       stage("Collecting Essential Test Context",
+            node: :context,
             body: ->(s) { @test_build_setup.stage_collect_test_context(s) }
       ),
 
       # Stage 3
       stage("Ingesting Test Configurations",
+            node: :context,
             body: ->(s) { @test_build_setup.stage_ingest_configurations(s) }
       ),
 
+      # Transform 1: Identify tests whose preprocessing, mocks & runners an earlier build
+      # in this run generated (e.g. `test:all` before `gcov:all`)
+      stage(transform: true,
+            body: ->(s) { @test_build_planner.stage_identify_shared_artifacts(s) }
+      ),
+
       # Stage 4
       stage("Collecting More Test Context",
+            node: :context,
             condition: use_preprocessing,
             body: ->(s) { @test_build_setup.stage_collect_preprocessor_context(s) }
       ),
@@ -147,7 +168,12 @@ class TestInvoker
             body: ->(s) { @test_build_planner.stage_determine_files(s) }
       ),
 
-      # Transform 1: Prepare partials parallel processing
+      # Transform 2: Restore runner & Partials details of tests reusing shared artifacts
+      stage(transform: true,
+            body: ->(s) { @test_build_planner.stage_restore_shared_artifacts(s) }
+      ),
+
+      # Transform 3: Prepare partials parallel processing
       stage(transform: true,
             condition: use_partials,
             body: ->(s) { @test_build_planner.stage_flatten_partials_lists(s) }
@@ -155,23 +181,26 @@ class TestInvoker
 
       # Stage 6
       stage("Preprocessing for Testing & Mocking Partials",
+            node: :partials,
             condition: use_partials,
             body: ->(s) { @test_build_executor.stage_preprocess_partial_headers(s) }
       ),
 
       # Stage 7
       stage("Preprocessing for Testing Partials",
+            node: :partials,
             condition: use_partials,
             body: ->(s) { @test_build_executor.stage_preprocess_partial_sources(s) }
       ),
 
       # Stage 8
       stage("Partials",
+            node: :partials,
             condition: use_partials,
             body: ->(s) { @test_build_executor.stage_generate_partials(s) }
       ),
 
-      # Transform 2: Prepare mocks for parallel processing
+      # Transform 4: Prepare mocks for parallel processing
       stage(transform: true,
             condition: use_mocks,
             body: ->(s) { @test_build_planner.stage_flatten_mocks_list(s) }
@@ -179,40 +208,50 @@ class TestInvoker
 
       # Stage 9
       stage("Preprocessing for Mocks",
+            node: :mocks,
             condition: use_mocks_preproc,
             body: ->(s) { @test_build_executor.stage_preprocess_mocks(s) }
       ),
 
       # Stage 10
       stage("Mocking",
+            node: :mocks,
             condition: use_mocks,
             body: ->(s) { @test_build_executor.stage_generate_mocks(s) }
       ),
 
       # Stage 11
       stage("Preprocessing Test Files",
+            node: :runner,
             condition: use_preprocessing,
             body: ->(s) { @test_build_executor.stage_preprocess_test_files(s) }
       ),
 
       # Stage 12
       stage("Collecting More Test Context",
+            node: :runner,
             condition: use_preprocessing,
             body: ->(s) { @test_build_executor.stage_collect_runner_details(s) }
       ),
 
       # Stage 13
       stage("Test Runners",
+            node: :runner,
             body: ->(s) { @test_build_executor.stage_generate_runners(s) }
       ),
 
+      # Transform 5: Record shared artifacts for reuse by builds in other contexts
+      stage(transform: true,
+            body: ->(s) { @test_build_planner.stage_record_shared_artifacts(s) }
+      ),
+
       # Stage 14
       stage("Determining Artifacts to Be Built",
             heading: false,
             body: ->(s) { @test_build_planner.stage_determine_artifacts(s) }
       ),
 
-      # Transform 3: Prepare objects for parallel processing
+      # Transform 6: Prepare objects for parallel processing
       stage(transform: true,
             body: ->(s) { @test_build_planner.stage_flatten_objects_list(s) }
       ),
@@ -220,28 +259,32 @@ class TestInvoker
       # Stage 15 — skipped under :sources_only (no object compilation needed to
       # determine which sources a test references).
       stage("Building Objects",
+            node: :objects,
             condition: not_sources_only,
             body: ->(s) { @test_build_executor.stage_build_objects(s) }
       ),
 
       # Stage 16 — skipped under :sources_only (no linking needed either).
       stage("Building Test Executables",
+            node: :link,
             condition: not_sources_only,
             body: ->(s) { @test_build_executor.stage_build_executables(s) }
       ),
 
       # Stage 17 — skipped under :build_only or :sources_only.
       stage("Executing",
+            node: :run,
             condition: ->(s) { not_build_only.call(s) && not_sources_only.call(s) },
             body: ->(s) { @test_build_executor.stage_execute(s) }
       ),
     ]
   end
 
-  def stage(name = nil, heading: true, condition: nil, transform: false, body:)
+  def stage(name = nil, heading: true, node: nil, condition: nil, transform: false, body:)
     Stage.new(
       name:      name,
       heading:   heading,
+      node:      node,
       condition: condition,
       transform: transform,
       body:      body
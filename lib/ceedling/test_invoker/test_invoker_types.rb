@@ -16,10 +16,10 @@ module TestInvokerTypes
     :testables,         # Hash<Symbol, Testable> — accumulated across all stages
     :context,
     :options,
-    :partials_headers,  # Produced by T1; consumed by stages 6 & 7
-    :partials_sources,  # Produced by T1; consumed by stages 6 & 7
-    :mocks_list,        # Produced by T2; consumed by stages 9 & 10
-    :objects_list,      # Produced by T3; consumed by stage 15
+    :partials_headers,  # Produced by T3; consumed by stages 6 & 7
+    :partials_sources,  # Produced by T3; consumed by stages 6 & 7
+    :mocks_list,        # Produced by T4; consumed by stages 9 & 10
+    :objects_list,      # Produced by T6; consumed by stage 15
     :lock,              # Mutex for thread-safe testable writes
     keyword_init: true
   )
@@ -31,6 +31,7 @@ module TestInvokerTypes
     :paths,                                    # Hash — build/results/mocks/partials/preprocess paths
     :preprocess,                               # Hash — preprocessing scratch state
     :search_paths,
+    :minimal_search_paths,                     # Array — subset of search paths a previous build needed (or nil)
     :compile_flags, :preprocess_flags, :assembler_flags, :link_flags,
     :compile_defines, :preprocess_defines,
     :runner,                                   # Hash — {output_filepath:, input_filepath:}
@@ -38,16 +39,20 @@ module TestInvokerTypes
     :partials,                                 # TestablePartials — configs map + tests/mocks module name lists
     :sources, :frameworks, :core, :objects, :executable,
     :no_link_objects, :results_pass, :results_fail,
+    :jumbo,                                    # Hash — jumbo build unit object → generated unit source
+    :shared,                                   # Boolean — context-independent artifacts reused from an earlier build
     keyword_init: true
   ) do
     def initialize(**kwargs)
       kwargs[:partials] ||= TestablePartials.new(configs: {}, tests: [], mocks: [])
+      kwargs[:jumbo]    ||= {}
       super(**kwargs)
     end
   end
 
   # Describes one pipeline step — either a named build_step or a silent transform.
-  Stage = Struct.new(:name, :heading, :condition, :transform, :body, keyword_init: true) do
+  # `node` is the step's place in a test's dependency chain (see Explainer::CHAIN), if any.
+  Stage = Struct.new(:name, :heading, :node, :condition, :transform, :body, keyword_init: true) do
     def run?(state)
       condition.nil? || condition.call(state)
     end
@@ -0,0 +1,100 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'json'
+require 'rake' # for ext()
+require 'ceedling/constants'
+require 'ceedling/exceptions'
+
+##
+## Storage for test results (.pass / .fail files).
+##
+## Results are written to disk once per test executable run and also retained in
+## memory so that reporting at the end of the same build (test summaries, plugins)
+## never parses a results file. Results files from a previous build are loaded
+## lazily on first request (e.g. `ceedling summary`).
+##
+## The on-disk format is compact JSON by default. YAML remains available as an
+## export format (`:test_build` ↳ `:results_format`). Loading detects either format
+## regardless of configuration so results from earlier builds remain readable.
+##
+class TestResultsStore
+
+  constructor :configurator, :file_wrapper, :yaml_wrapper
+
+  def setup()
+    # Results keyed by results filepath minus .pass / .fail extension
+    @results = {}
+    @lock = Mutex.new
+  end
+
+
+  def write(filepath, results)
+    @lock.synchronize { @results[key( filepath )] = results }
+
+    case @configurator.test_build_results_format
+    when :yaml
+      @yaml_wrapper.dump( filepath, results )
+    else
+      @file_wrapper.write( filepath, JSON.generate( scrub( results ) ) )
+    end
+  end
+
+
+  # Returns results for a results filepath (with or without extension) if already written or loaded this build
+  def fetch(filepath)
+    return @lock.synchronize { @results[key( filepath )] }
+  end
+
+
+  # Load results from disk and retain them in memory
+  def load(filepath)
+    contents = @file_wrapper.read( filepath )
+
+    results =
+      # JSON results always begin with the opening of a hash
+      if contents.start_with?( '{' )
+        begin
+          JSON.parse( contents, symbolize_names: true )
+        rescue JSON::ParserError => ex
+          raise CeedlingException.new( "Malformed JSON content in #{filepath} ⏩️ #{ex.message}" )
+        end
+      else
+        @yaml_wrapper.load_string( contents, source_label: filepath )
+      end
+
+    @lock.synchronize { @results[key( filepath )] = results }
+
+    return results
+  end
+
+
+  ### Private ###
+
+  private
+
+  def key(filepath)
+    return filepath.ext( '' )
+  end
+
+
+  # Copy of results safe to encode as JSON.
+  # Captured test executable output can hold any bytes, but JSON text must be valid UTF-8.
+  def scrub(value)
+    case value
+    when Hash
+      return value.transform_values {|element| scrub( element ) }
+    when Array
+      return value.map {|element| scrub( element ) }
+    when String
+      return value.dup.force_encoding( Encoding::UTF_8 ).scrub()
+    else
+      return value
+    end
+  end
+
+end
@@ -8,6 +8,8 @@
 require 'ceedling/constants'
 require 'ceedling/exceptions'
 require 'benchmark'
+require 'digest'
+require 'fileutils'
 
 class ToolExecutor
 
@@ -16,12 +18,23 @@ class ToolExecutor
     tool[:name] = default if tool[:name].nil?
   end
 
-  constructor :configurator, :tool_executor_helper, :loginator, :verbosinator, :system_wrapper, :ruby_expandinator
+  constructor :configurator, :tool_executor_helper, :loginator, :verbosinator, :system_wrapper, :ruby_expandinator, :profiler, :explainer
+
+  def setup()
+    # Tool config hash (by identity) => compiled command template (see `compile_tool()`)
+    @templates = {}.compare_by_identity
+    # Response files known to already exist
+    @response_files = {}
+    @lock = Mutex.new
+  end
 
   # build up a command line from yaml provided config
 
   # @param extra_params is an array of parameters to append to executable (prepend to rest of command line)
-  def build_command_line(tool_config, extra_params, *args)
+  # @param response_file optionally moves the expansion of `${#}` input replacements into a GCC-style
+  #        `@file` response file: `{:path => <directory>, :replacements => [<1-indexed replacement numbers>]}`.
+  #        The expanded arguments are replaced on the command line by `@<file>` at the position of the first.
+  def build_command_line(tool_config, extra_params, *args, response_file: nil)
     command = {}
 
     command[:name] = tool_config[:name]
@@ -29,17 +42,15 @@ class ToolExecutor
 
     command[:options] = {} # Blank to hold options set before `exec()` processes
 
-    # Basic premise is to iterate top to bottom through arguments using '$' as
-    # a string replacement indicator to expand globals or inline yaml arrays
-    # into command line arguments via substitution strings.
-    executable = @tool_executor_helper.osify_path_separators(
-      expandify_element(tool_config[:name], tool_config[:executable], *args)
-    )
+    template = tool_template( tool_config )
+
+    executable = template[:executable]
+    executable = @tool_executor_helper.osify_path_separators( render_element( tool_config[:name], executable, *args ) ) if executable.is_a?( Hash )
 
     command[:line] = [
       executable,
       extra_params.join(' ').strip,
-      build_arguments(tool_config[:name], tool_config[:arguments], *args),
+      build_arguments(tool_config[:name], template[:arguments], *args, response_file: response_file),
       ].reject{|s| s.nil? || s.empty?}.join(' ').strip
 
     # Log command as is
@@ -52,7 +63,11 @@ class ToolExecutor
   end
 
   # shell out, execute command, and return response
-  def exec(command, args=[])
+  # If a block is given, it is called with (:stdout | :stderr, chunk) as output arrives,
+  # and `options[:output_limit]` optionally bounds the output retained in the response.
+  # `options[:chdir]` and `options[:env]` set a working directory and environment variables
+  # for this command alone.
+  def exec(command, args=[], &block)
     options = command[:options]
 
     options[:boom] = true if (options[:boom].nil?)
@@ -72,13 +87,23 @@ class ToolExecutor
       :exit_code => 0
     }
 
+    @explainer.command( command_line )
+
     # Wrap system level tool execution in exception handling
     begin
       time = Benchmark.realtime do 
-        shell_result = @system_wrapper.shell_capture3( command:command_line, boom:options[:boom] )
+        @profiler.span( command[:name], category: :tool ) do
+          if block.nil?
+            shell_result = @system_wrapper.shell_capture3( command:command_line, boom:options[:boom], chdir:options[:chdir], env:(options[:env] || {}) )
+          else
+            shell_result = @system_wrapper.shell_stream( command:command_line, boom:options[:boom], limit:options[:output_limit], chdir:options[:chdir], env:(options[:env] || {}), &block )
+          end
+        end
       end
       shell_result[:time] = time
 
+      @loginator.event( :tool, {:tool => command[:name], :duration => time.round( 6 ), :exit_code => shell_result[:exit_code]} )
+
     # Ultimately, re-raise the exception as ShellException populated with the exception message
     rescue => error
       raise ShellException.new( name:pretty_tool_name( command ), message: "#{command_line}\n#{error.message}" )
@@ -106,33 +131,164 @@ class ToolExecutor
   private #############################
 
 
-  def build_arguments(tool_name, config, *args)
-    build_string = ''
+  # Compiled command template of a tool config -- compiled on first use and again only if the
+  # tool's executable or arguments are changed (e.g. by a plugin or Rakefile).
+  def tool_template(tool_config)
+    signature = [tool_config[:executable], tool_config[:arguments]].hash
 
-    return nil if (config.nil?)
+    template = @lock.synchronize { @templates[tool_config] }
+    return template if !template.nil? and (template[:signature] == signature)
 
-    # Iterate through each argument
+    template = compile_tool( tool_config )
+    template[:signature] = signature
+
+    @lock.synchronize { @templates[tool_config] = template }
+    return template
+  end
+
+  # Basic premise is to iterate top to bottom through arguments using '$' as
+  # a string replacement indicator to expand globals or inline yaml arrays
+  # into command line arguments via substitution strings.
+  #
+  # Each element becomes either its final (static) text or a Hash describing the per-call
+  # work left to do. Only `${#}` input replacements and inline Ruby string expansion (which
+  # may evaluate differently from call to call) are deferred; all else is resolved now.
+  def compile_tool(tool_config)
+    name = tool_config[:name]
+
+    executable = compile_element( name, tool_config[:executable] )
+    executable = @tool_executor_helper.osify_path_separators( executable ) if executable.is_a?( String )
 
     # The yaml blob array needs to be flattened so that yaml alias substitution is handled
     # correctly as it creates a nested array when an anchor is dereferenced
-    config.flatten.each do |element|
-      argument = ''
-
+    arguments = (tool_config[:arguments] || []).flatten.map do |element|
       case(element)
         # If we find a simple string then look for string replacement operators
         #  and expand with the parameters in this method's argument list
-        when String then argument = expandify_element(tool_name, element, *args)
+        when String then compile_element( name, element )
         # If we find a hash, then we grab the key as a substitution string and expand the
         #  hash's value(s) within that substitution string
-        when Hash   then argument = dehashify_argument_elements(tool_name, element)
+        when Hash
+          if element.values.flatten.any? {|item| item.is_a?( String ) and @ruby_expandinator.replacement?( item )}
+            { :hash => element }
+          else
+            dehashify_argument_elements( name, element )
+          end
+        else ''
+      end
+    end
+
+    return {
+      :executable => executable,
+      :arguments  => arguments.reject {|argument| argument.is_a?( String ) and argument.empty?}
+    }
+  end
+
+  # A string element with a `${#}` input replacement is compiled to its replacement operator
+  # and (0-indexed) argument position; see `expandify_element()` for the expansion it defers.
+  def compile_element(tool_name, element)
+    return '' if element.nil?
+
+    match = PATTERNS::TOOL_EXECUTOR_ARGUMENT_REPLACEMENT.match( element )
+    if !match.nil?
+      return {
+        :element  => element.sub(/\\\$/, '$').strip,
+        :operator => match[1],
+        # Convert argument numbering from configuration 1-indexed to array 0-indexed
+        :index    => (match[2].to_i - 1)
+      }
+    end
+
+    return { :element => element.sub(/\\\$/, '$').strip } if @ruby_expandinator.replacement?( element )
+
+    return expandify_element( tool_name, element )
+  end
+
+  # Per-call expansion of a deferred template element
+  def render_element(tool_name, deferred, *args)
+    return dehashify_argument_elements( tool_name, deferred[:hash] ) if deferred.key?( :hash )
+
+    element = deferred[:element]
+    build_string = element
+
+    if deferred.key?( :operator )
+      args_size = args.nil? ? 0 : args.size()
+
+      if (args_size == 0)
+        error = "Command building for tool '#{tool_name}' expects argument data but was provided none."
+        raise CeedlingException.new( error )
       end
 
-      build_string.concat("#{argument} ") if (argument.length > 0)
+      if (deferred[:index] >= args_size)
+        error = "Command building for tool '#{tool_name}' was provided only #{args_size} arguments but references a replacement operator #{deferred[:operator]}."
+        raise CeedlingException.new( error )
+      end
+
+      to_process = args[deferred[:index]]
+
+      build_string =
+        case (to_process)
+          when Array then to_process.map {|value| element.sub( deferred[:operator], value.to_s )}.join(' ')
+          else element.sub( deferred[:operator], to_process.to_s )
+        end
+    end
+
+    # Handle inline ruby string substitution
+    return @ruby_expandinator.expand( build_string, source: "tool '#{tool_name}'" ).strip
+  end
+
+  def build_arguments(tool_name, arguments, *args, response_file: nil)
+    build = []
+    contents = []
+    position = nil
+
+    arguments.each do |element|
+      argument = element.is_a?( String ) ? element : render_element( tool_name, element, *args )
+      next if (argument.length == 0)
+
+      if response_file?( element, response_file )
+        position ||= build.size
+        contents << argument
+      else
+        build << argument
+      end
+    end
+
+    build.insert( position, "\"@#{write_response_file( response_file[:path], contents )}\"" ) if !position.nil?
+
+    return nil if build.empty?
+    return build.join(' ')
+  end
+
+  # Deferred `${#}` input replacement element named for inclusion in a response file
+  def response_file?(element, response_file)
+    return false if response_file.nil?
+    return false if !element.is_a?( Hash ) or !element.key?( :operator )
+    return response_file[:replacements].include?( element[:index] + 1 )
+  end
+
+  # Write (once) a response file named for a digest of its contents and return its filepath.
+  # Response files are shared by every command expanding the same arguments (e.g. the search
+  # paths and defines of all compilations for a test) and are never rewritten.
+  def write_response_file(path, contents)
+    # Response file quoting follows the shell except that a backslash always escapes the
+    # character following it -- preserve backslashes the shell would have left as is
+    text = contents.map {|argument| argument.gsub( /\\(?![\\"$`])/, '\\\\\\\\' )}.join("\n") + "\n"
+
+    filepath = File.join( path, "#{Digest::SHA256.hexdigest( text )}.rsp" )
+
+    return filepath if @lock.synchronize { @response_files[filepath] }
+
+    if !File.exist?( filepath )
+      # Written alongside and moved into place so that no command ever reads a partial file
+      FileUtils.mkdir_p( path )
+      temp = "#{filepath}.#{Process.pid}.#{Thread.current.object_id}"
+      File.write( temp, text )
+      File.rename( temp, filepath )
     end
 
-    build_string.strip!
-    return build_string if (build_string.length > 0)
-    return nil
+    @lock.synchronize { @response_files[filepath] = true }
+    return filepath
   end
 
 
@@ -164,8 +320,8 @@ class ToolExecutor
     end
 
     # Simple string argument: replace escaped '\$' and strip
-    element.sub!(/\\\$/, '$')
-    element.strip!
+    # (a copy -- the tool configuration's own text is left as is for later command building)
+    element = element.sub(/\\\$/, '$').strip
 
     build_string = ''
 
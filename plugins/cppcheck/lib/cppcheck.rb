@@ -7,12 +7,15 @@
 
 require 'ceedling/constants'
 require 'ceedling/plugins/plugin'
+require 'digest'
 
 require 'cppcheck_constants'
 require 'cppcheck_reports'
+require 'cppcheck_results'
 
 class Cppcheck < Plugin
   def setup
+    @batchinator = @ceedling[:batchinator]
     @configurator = @ceedling[:configurator]
     @file_path_collection_utils = @ceedling[:file_path_collection_utils]
     @file_wrapper = @ceedling[:file_wrapper]
@@ -46,6 +49,10 @@ class Cppcheck < Plugin
         @reports[type] = report
       end
     end
+
+    # Direct #includes of each file scanned for analysis fingerprints (filepath => [filepaths])
+    @includes = {}
+    @includes_lock = Mutex.new
   end
   
   def generate_reports()
@@ -64,6 +71,21 @@ class Cppcheck < Plugin
       else
         @reports.values
       end
+    
+    # Analyze each source once (or reuse its cached results) and write XML-based reports from them.
+    # Other formats are Cppcheck's own output of a whole project run.
+    if @config[:incremental] && !using_project_file
+      merged, whole = reports_to_do.partition {|report| report.from_results?}
+      
+      if !merged.empty?
+        results = analyze_files(analysis_filepaths())
+        merged.each {|report| report.generate_from_results(results)}
+      end
+      
+      whole.each {|report| report.generate(opts, *args)}
+      return
+    end
+    
     reports_to_do.each {|report| report.generate(opts, *args)}
   end
   
@@ -232,6 +254,122 @@ class Cppcheck < Plugin
     return opts
   end
   
+  # Per-file analysis in parallel, each file's XML output kept as a fragment beside a fingerprint
+  # of its inputs. A fragment is reused as long as its fingerprint matches.
+  def analyze_files(filepaths)
+    opts = build_fragment_opts()
+    settings = fragment_settings_key(opts)
+    
+    analyzed = @batchinator.exec(workload: :compile, things: filepaths) do |filepath|
+      fragment = form_fragment_filepath(filepath)
+      fingerprint = fragment + EXTENSION_CPPCHECK_FINGERPRINT
+      digest = fragment_digest(filepath, settings)
+      
+      if @file_wrapper.exist?(fragment) && @file_wrapper.exist?(fingerprint) && (@file_wrapper.read(fingerprint) == digest)
+        next [fragment, false]
+      end
+      
+      msg = @reportinator.generate_progress( "Running Cppcheck on file #{filepath}" )
+      @loginator.log( msg, Verbosity::NORMAL )
+      
+      @file_wrapper.mkdir(File.dirname(fragment))
+      run_tool(TOOLS_CPPCHECK, opts + ["--output-file=#{fragment}"], COLLECTION_PATHS_INCLUDE, filepath)
+      @file_wrapper.write(fingerprint, digest)
+      
+      [fragment, true]
+    end
+    
+    skipped = analyzed.count {|_, ran| !ran}
+    if skipped > 0
+      msg = "Reused Cppcheck results for #{skipped} unchanged source file(s)."
+      @loginator.log(msg, Verbosity::NORMAL)
+    end
+    
+    return CppcheckResults.new(analyzed.map {|fragment, _| @file_wrapper.read(fragment)})
+  end
+  
+  # Project sources less any `:excludes` (given as files or directories)
+  def analysis_filepaths()
+    excludes = (@config[:excludes] || []).map {|exclude| exclude.chomp('/')}
+    
+    return COLLECTION_ALL_SOURCE.reject do |filepath|
+      excludes.any? do |exclude|
+        (filepath == exclude) || filepath.start_with?(exclude + '/') || filepath.end_with?('/' + exclude)
+      end
+    end
+  end
+  
+  # Whole project options with per-file XML output. Cppcheck's own incremental build directory
+  # is not shared between parallel runs, and `unusedFunction` cannot be judged one file at a time.
+  def build_fragment_opts()
+    opts = build_project_opts()
+    opts.reject! {|opt| opt.start_with?('--cppcheck-build-dir=')}
+    opts << '--suppress=unusedFunction'
+    opts << '--xml'
+    opts << "--xml-version=#{@config[:xml_report_version] || 3}"
+    return opts
+  end
+  
+  # Everything but the analyzed file and its #includes that shapes analysis results
+  def fragment_settings_key(opts)
+    key = [TOOLS_CPPCHECK[:executable], opts, COLLECTION_PATHS_INCLUDE].flatten.join("\0").b
+    
+    # Contents of suppressions and forced includes matter, not only their names
+    (COLLECTION_ALL_CPPCHECK + (@config[:includes] || [])).each do |filepath|
+      key << "\0#{filepath}\0".b << File.binread(filepath) if File.file?(filepath)
+    end
+    
+    return key
+  end
+  
+  def fragment_digest(filepath, settings)
+    digest = Digest::SHA256.new
+    digest << settings
+    
+    include_closure(filepath).each do |_filepath|
+      digest << "\0" << _filepath << "\0" << File.binread(_filepath)
+    end
+    
+    return digest.hexdigest
+  end
+  
+  # The file and every project header it #includes, directly or indirectly
+  def include_closure(filepath)
+    closure = [filepath]
+    pending = [filepath]
+    
+    while (current = pending.shift)
+      direct_includes(current).each do |include|
+        next if closure.include?(include)
+        closure << include
+        pending << include
+      end
+    end
+    
+    return closure.sort
+  end
+  
+  # #includes of a file found beside it or among the project's include paths
+  def direct_includes(filepath)
+    cached = @includes_lock.synchronize { @includes[filepath] }
+    return cached if !cached.nil?
+    
+    search_paths = [File.dirname(filepath)] + COLLECTION_PATHS_INCLUDE
+    
+    includes = File.binread(filepath).scan(/^\s*#\s*include\s*[<"]([^>"]+)[>"]/).map do |(name)|
+      search_paths.map {|path| File.join(path, name)}.find {|_filepath| File.file?(_filepath)}
+    end.compact.uniq
+    
+    @includes_lock.synchronize { @includes[filepath] = includes }
+    return includes
+  end
+  
+  def form_fragment_filepath(filepath)
+    # Mirror the source tree without leaving the fragments directory
+    relative = filepath.sub(/\A([A-Za-z]:)?[\/\\]+/, '').gsub('..', '__')
+    return File.join(CPPCHECK_FRAGMENTS_PATH, relative + '.xml')
+  end
+  
   def run_tool(tool, opts, *args)
     command = @tool_executor.build_command_line(
       tool,
@@ -36,8 +36,21 @@ class CppcheckReport
     run_tool(TOOLS_CPPCHECK, opts, *args)
   end
   
+  # Whether the report can be written from merged per-file results (see `generate_from_results()`)
+  def from_results? = false
+  
+  # Write the report from merged per-file results rather than running Cppcheck again
+  def generate_from_results(results)
+    @loginator.log("Creating Cppcheck #{report_type} report...", Verbosity::NORMAL)
+    @file_wrapper.write(@artifact_filepath, render(results))
+  end
+  
   private
   
+  def render(results)
+    raise NotImplementedError, "#{self.class} must implement render"
+  end
+  
   def form_artifact_filepath(filename, extension)
     return File.join(
       CPPCHECK_ARTIFACTS_PATH,
@@ -72,12 +85,19 @@ class CppcheckHtmlReport < CppcheckReport
   
   def report_type = :html
   
+  def from_results? = true
+  
   def generate(opts, *args)
     msg = @reportinator.generate_progress( "Creating Cppcheck #{report_type} report" )
     @loginator.log(msg, Verbosity::NORMAL)
     run_tool(TOOLS_CPPCHECK_HTMLREPORT, build_opts())
   end
   
+  # Built from the XML report, itself written from the results beforehand
+  def generate_from_results(results)
+    generate([])
+  end
+  
   private
   
   def build_opts
@@ -142,8 +162,14 @@ class CppcheckXmlReport < CppcheckReport
 
   def report_type = :xml
 
+  def from_results? = true
+
   private
 
+  def render(results)
+    results.to_xml
+  end
+
   def build_opts
     super + ["--xml", "--xml-version=#{@xml_version}"]
   end
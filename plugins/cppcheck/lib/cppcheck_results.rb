@@ -0,0 +1,57 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'rexml/document'
+
+# Findings of per-file Cppcheck XML fragments merged into one set of Cppcheck XML
+# results. Other report formats are left to Cppcheck itself.
+class CppcheckResults
+
+  attr_reader :errors
+
+  # `fragments` is a list of Cppcheck XML output strings (v2 or v3) in report order
+  def initialize(fragments)
+    @document = nil
+    @errors = []
+
+    seen = {}
+
+    fragments.each do |fragment|
+      document = REXML::Document.new( fragment )
+      @document ||= document
+
+      document.elements.each( 'results/errors/error' ) do |error|
+        # A header analyzed along with several sources yields the same finding for each
+        key = error.to_s
+        next if seen.key?( key )
+        seen[key] = true
+        @errors << error
+      end
+    end
+  end
+
+  def cppcheck_version
+    return nil if @document.nil?
+    return @document.elements['results/cppcheck']&.attributes&.[]( 'version' )
+  end
+
+  def to_xml
+    document = @document.nil? ? REXML::Document.new( '<results><errors/></results>' ) : @document.deep_clone
+    document.context[:attribute_quote] = :quote
+
+    errors = document.elements['results/errors'] || document.root.add_element( 'errors' )
+    errors.elements.delete_all( 'error' )
+    @errors.each { |error| errors.add_element( error.deep_clone ) }
+
+    xml = ''
+    formatter = REXML::Formatters::Pretty.new( 4 )
+    formatter.compact = true
+    formatter.write( document, xml )
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" + xml.sub( /\A<\?xml[^>]*\?>\s*/, '' ) + "\n"
+  end
+
+end
@@ -9,10 +9,12 @@ require 'ceedling/plugins/plugin'
 require 'ceedling/constants'
 require 'ceedling/exceptions'
 require 'pathname'
+require 'digest'
 
 DEPENDENCIES_ROOT_NAME = 'dependencies'
 DEPENDENCIES_TASK_ROOT = DEPENDENCIES_ROOT_NAME + ':'
 DEPENDENCIES_SYM       = DEPENDENCIES_ROOT_NAME.to_sym
+DEPENDENCIES_CACHE_DIR = 'dependencies_cache'
 
 class Dependencies < Plugin
 
@@ -36,6 +38,16 @@ class Dependencies < Plugin
 
     # Validate fetch tools per the configuration
     @dependencies.each {|_, config| validate_fetch_tools( config )}
+
+    # Validate dependencies among dependencies
+    DEPENDENCIES_DEPS.each {|deplib| validate_depends_on( deplib, [] )}
+
+    # Worker threads resolve paths against the project root (see `make_if_required()`)
+    @project_root = Dir.pwd
+    # Serializes build steps that change the working directory or global constants
+    @lock = Mutex.new
+    @cache_keys = {}
+    @artifact_paths = {}
   end
 
   def config()
@@ -137,27 +149,45 @@ class Dependencies < Plugin
     (deplib[:artifacts][:includes] || []).map {|path| File.join(get_artifact_path(deplib), path)}
   end
 
-  def set_env_if_required(lib_path)
-    blob = @dependencies[lib_path]
-    raise CeedlingException.new( "Could not find dependency '#{lib_path}'" ) if blob.nil?
-    return if (blob[:environment].nil?)
-    return if (blob[:environment].empty?)
+  # Names of the dependencies that must be ready before this one is fetched and built
+  def get_depends_on(deplib)
+    return (deplib[:depends_on] || []).map {|name| name.to_s}
+  end
 
-    blob[:environment].each do |e|
-      m = e.match(/^(\w+)\s*(\+?\-?=)\s*(.*)$/)
-      unless m.nil?
-        case m[2]
-        when "+="
-          ENV[m[1]] = (ENV[m[1]] || "") + m[3]
-        when "-="
-          ENV[m[1]] = (ENV[m[1]] || "").gsub(m[3],'')
-        else
-          ENV[m[1]] = m[3]
-        end
+  # Fetch and build every named dependency (all by default) whose artifacts are missing,
+  # along with any missing dependencies they depend on. A dependency is handled only
+  # once all it depends on are ready; independent dependencies are handled in parallel.
+  # With the artifact cache enabled, previously built artifacts are restored instead.
+  def make_if_required(names=nil)
+    names = DEPENDENCIES_DEPS.map {|deplib| deplib[:name]} if names.nil?
+    blobs = with_prerequisites( names.map {|name| lookup( name )} )
+
+    pending = blobs.select {|blob| artifacts_missing?( blob )}
+    return if pending.empty?
+
+    # Cache lookups, artifact paths and environments are determined up front -- worker
+    # threads never resolve relative paths or read the process environment
+    pending.each {|blob| cache_key( blob )}
+
+    waves( pending ).each do |wave|
+      environment = ENV.to_h
+      envs = wave.map {|blob| apply_environment( blob, environment.dup ).reject {|key, value| environment[key] == value}}
+
+      # The process environment is updated as before (in dependency order) for anything run later
+      wave.each {|blob| set_env_if_required( blob[:name] )}
+
+      @ceedling[:batchinator].exec( workload: :compile, things: wave.zip( envs ) ) do |blob, env|
+        make_dependency( blob, env )
       end
     end
   end
 
+  def set_env_if_required(lib_path)
+    blob = @dependencies[lib_path]
+    raise CeedlingException.new( "Could not find dependency '#{lib_path}'" ) if blob.nil?
+    apply_environment( blob, ENV )
+  end
+
   def generate_command_line(cmdline, name=nil)
     # Break apart command line at white spaces
     cmdline_items = cmdline.split(/\s+/)
@@ -183,7 +213,8 @@ class Dependencies < Plugin
     return command
   end
 
-  def fetch_if_required(lib_path)
+  # `env` holds environment variables for the fetch commands alone
+  def fetch_if_required(lib_path, env={})
     blob = @dependencies[lib_path]
 
     raise CeedlingException.new( "Could not find dependency '#{lib_path}'" ) if blob.nil?
@@ -198,7 +229,8 @@ class Dependencies < Plugin
       return
     end
 
-    FileUtils.mkdir_p(get_fetch_path(blob)) unless File.exist?(get_fetch_path(blob))
+    fetch_path = absolute_path( get_fetch_path(blob) )
+    FileUtils.mkdir_p(fetch_path) unless File.exist?(fetch_path)
 
     steps = []
 
@@ -289,14 +321,15 @@ class Dependencies < Plugin
 
     # Perform the actual fetching
     @ceedling[:loginator].log("Fetching dependency #{blob[:name]}...", Verbosity::NORMAL)
-    Dir.chdir(get_fetch_path(blob)) do
-      steps.each do |step|
-        @ceedling[:tool_executor].exec( step )
-      end
+    steps.each do |step|
+      step[:options][:chdir] = fetch_path
+      step[:options][:env] = env
+      @ceedling[:tool_executor].exec( step )
     end
   end
 
-  def build_if_required(lib_path)
+  # `env` holds environment variables for the build commands alone
+  def build_if_required(lib_path, env={})
     blob = @dependencies[lib_path]
     raise CeedlingException.new( "Could not find dependency '#{lib_path}'" ) if blob.nil?
 
@@ -306,18 +339,24 @@ class Dependencies < Plugin
       return
     end
 
-    FileUtils.mkdir_p(get_source_path(blob)) unless File.exist?(get_source_path(blob))
-    FileUtils.mkdir_p(get_artifact_path(blob)) unless File.exist?(get_artifact_path(blob))
+    source_path = absolute_path( get_source_path(blob) )
+    artifact_path = absolute_path( get_artifact_path(blob) )
+    FileUtils.mkdir_p(source_path) unless File.exist?(source_path)
+    FileUtils.mkdir_p(artifact_path) unless File.exist?(artifact_path)
 
     # Perform the build
     @ceedling[:loginator].log("Building dependency #{blob[:name]}...", Verbosity::NORMAL)
-    Dir.chdir(get_source_path(blob)) do
-      blob[:build].each do |step|
-        if (step.class == Symbol)
-          exec_dependency_builtin_command(step, blob)
-        else
-          @ceedling[:tool_executor].exec( generate_command_line(step) )
+    blob[:build].each do |step|
+      if (step.class == Symbol)
+        # Built-in commands work relative to the working directory and set global constants
+        @lock.synchronize do
+          Dir.chdir(source_path) { exec_dependency_builtin_command(step, blob) }
         end
+      else
+        command = generate_command_line(step)
+        command[:options][:chdir] = source_path
+        command[:options][:env] = env
+        @ceedling[:tool_executor].exec( command )
       end
     end
   end
@@ -507,6 +546,236 @@ class Dependencies < Plugin
 
   private
 
+  def lookup(name)
+    blob = @dependencies[name.to_s] || DEPENDENCIES_DEPS.find {|deplib| get_name(deplib) == name.to_s}
+    raise CeedlingException.new( "Could not find dependency '#{name}'" ) if blob.nil?
+    return @dependencies[blob[:name]]
+  end
+
+  def validate_depends_on(deplib, chain)
+    if chain.include?( deplib[:name] )
+      raise CeedlingException.new( "Dependencies depend on one another in a cycle: #{(chain + [deplib[:name]]).join(' -> ')}" )
+    end
+
+    get_depends_on(deplib).each do |name|
+      prerequisite = DEPENDENCIES_DEPS.find {|_deplib| (_deplib[:name] == name) || (get_name(_deplib) == name)}
+      raise CeedlingException.new( "Dependency '#{deplib[:name]}' depends on unknown dependency '#{name}'" ) if prerequisite.nil?
+      validate_depends_on( prerequisite, chain + [deplib[:name]] )
+    end
+  end
+
+  # Dependencies plus everything they depend on (directly or indirectly)
+  def with_prerequisites(blobs)
+    all = []
+    visit = lambda do |blob|
+      next if all.include?( blob )
+      get_depends_on(blob).each {|name| visit.call( lookup( name ) )}
+      all << blob
+    end
+    blobs.each {|blob| visit.call( blob )}
+    return all
+  end
+
+  # Group dependencies such that each group depends only on those in earlier groups
+  # (dependencies outside `blobs` are already in place)
+  def waves(blobs)
+    depth = {}
+    measure = lambda do |blob|
+      depth[blob[:name]] ||= begin
+        prerequisites = get_depends_on(blob).map {|name| lookup( name )}.select {|_blob| blobs.include?( _blob )}
+        prerequisites.map {|_blob| measure.call( _blob ) + 1}.max || 0
+      end
+    end
+    blobs.each {|blob| measure.call( blob )}
+
+    return blobs.group_by {|blob| depth[blob[:name]]}.sort.map {|_, wave| wave}
+  end
+
+  # Mirrors the existence checks of the rake tasks for a dependency's artifacts
+  # (wildcard include entries are not files themselves)
+  def artifacts_missing?(blob)
+    return artifact_paths( blob ).any? {|path| !File.exist?( path )}
+  end
+
+  def artifact_paths(blob)
+    return @artifact_paths[blob[:name]] ||= (
+      get_static_libraries_for_dependency(blob) +
+      get_dynamic_libraries_for_dependency(blob) +
+      get_include_directories_for_dependency(blob) +
+      get_include_files_for_dependency(blob).reject {|path| path.include?( '*' )} +
+      get_source_files_for_dependency(blob)
+    ).map {|path| absolute_path( path )}
+  end
+
+  # Environment variables of a dependency applied to `env` (the process `ENV` or a hash)
+  def apply_environment(blob, env)
+    (blob[:environment] || []).each do |e|
+      m = e.match(/^(\w+)\s*(\+?\-?=)\s*(.*)$/)
+      unless m.nil?
+        case m[2]
+        when "+="
+          env[m[1]] = (env[m[1]] || "") + m[3]
+        when "-="
+          env[m[1]] = (env[m[1]] || "").gsub(m[3],'')
+        else
+          env[m[1]] = m[3]
+        end
+      end
+    end
+
+    return env
+  end
+
+  def make_dependency(blob, env)
+    key = cache_key( blob )
+
+    return if restore_from_cache( blob, key )
+
+    fetch_if_required( blob[:name], env )
+    build_if_required( blob[:name], env )
+
+    store_in_cache( blob, key )
+  end
+
+  ##
+  ## Artifact cache
+  ##
+  ## Artifacts are cached by what was fetched and how it was built. Dependencies whose
+  ## fetch identity is unknown before fetching (a git branch, custom fetch commands, ...)
+  ## or with artifacts outside their artifact path are not cached.
+  ##
+
+  def cache_path()
+    return nil if !DEPENDENCIES_CACHE
+    path = DEPENDENCIES_CACHE_PATH.to_s
+    path = File.join( PROJECT_BUILD_ROOT, DEPENDENCIES_CACHE_DIR ) if path.empty?
+    return absolute_path( path )
+  end
+
+  def cache_key(blob)
+    return @cache_keys[blob[:name]] if @cache_keys.key?( blob[:name] )
+
+    key = nil
+    artifact_path = absolute_path( get_artifact_path(blob) )
+
+    # Only the artifact path is cached -- anything outside it would still need a fetch & build
+    cacheable = !cache_path().nil? && artifact_paths( blob ).all? {|path| path.start_with?( artifact_path + '/' )}
+    identity = cacheable ? fetch_identity( blob ) : nil
+
+    if !identity.nil?
+      prerequisite_keys = get_depends_on(blob).map {|name| cache_key( lookup( name ) )}
+
+      # Anything depending on an uncached dependency is not cached either
+      if !prerequisite_keys.include?( nil )
+        key = Digest::SHA256.hexdigest( ([identity, build_identity( blob )] + prerequisite_keys).join( "\n" ) )
+      end
+    end
+
+    @cache_keys[blob[:name]] = key
+    return key
+  end
+
+  def fetch_identity(blob)
+    fetch = blob[:fetch] || {}
+
+    case fetch[:method]
+    when :git
+      # A branch can move, a tag (by convention) or a commit hash cannot
+      revision = fetch[:hash] || fetch[:tag]
+      return revision.nil? ? nil : "git #{fetch[:source]} #{revision}"
+
+    when :svn
+      return fetch[:revision].nil? ? nil : "svn #{fetch[:source]} #{fetch[:revision]}"
+
+    when :zip, :tar_gzip
+      archive = File.expand_path( fetch[:source].to_s, absolute_path( get_fetch_path(blob) ) )
+      return File.file?( archive ) ? "#{fetch[:method]} #{Digest::SHA256.file( archive ).hexdigest}" : nil
+
+    when :none, nil
+      return "source #{source_digest( blob )}"
+
+    else # :custom
+      return nil
+    end
+  end
+
+  # Build configuration and (for built-in steps) the dependencies tools
+  def build_identity(blob)
+    build = [:build, :environment, :flags, :defines, :libraries, :libpaths, :source, :include, :paths, :artifacts].map {|key| blob[key]}
+
+    if (blob[:build] || []).any? {|step| step.class == Symbol}
+      [:TOOLS_DEPS_COMPILER, :TOOLS_DEPS_ASSEMBLER, :TOOLS_DEPS_LINKER].each do |tool|
+        build << (Object.const_defined?( tool ) ? Object.const_get( tool ) : nil)
+      end
+    end
+
+    return build.inspect
+  end
+
+  # Contents of a dependency's source directory, skipping its build output
+  def source_digest(blob)
+    source_path = absolute_path( get_source_path(blob) )
+    outputs = [get_build_path(blob), get_artifact_path(blob)].map {|path| absolute_path( path )}.reject {|path| path == source_path}
+
+    digest = Digest::SHA256.new
+    Dir.glob( File.join( source_path, '**', '*' ), File::FNM_DOTMATCH ).sort.each do |filepath|
+      next if !File.file?( filepath )
+      next if outputs.any? {|path| filepath.start_with?( path + '/' )}
+      digest << filepath.delete_prefix( source_path ) << "\0" << Digest::SHA256.file( filepath ).digest
+    end
+
+    return digest.hexdigest
+  end
+
+  def form_cache_entry_path(blob, key)
+    return File.join( cache_path(), "#{get_name(blob)}-#{key}" )
+  end
+
+  def restore_from_cache(blob, key)
+    return false if key.nil?
+
+    entry = form_cache_entry_path( blob, key )
+    return false if !File.directory?( entry )
+
+    @ceedling[:loginator].log("Restoring dependency #{blob[:name]} from cache...", Verbosity::NORMAL)
+    artifact_path = absolute_path( get_artifact_path(blob) )
+    FileUtils.mkdir_p( artifact_path )
+    FileUtils.cp_r( File.join( entry, '.' ), artifact_path )
+
+    return true if !artifacts_missing?( blob )
+
+    @ceedling[:loginator].log("Cached artifacts of dependency #{blob[:name]} are incomplete", Verbosity::COMPLAIN)
+    return false
+  end
+
+  # Everything in the artifact path is cached
+  def store_in_cache(blob, key)
+    return if key.nil?
+
+    entry = form_cache_entry_path( blob, key )
+    artifact_path = absolute_path( get_artifact_path(blob) )
+    return if File.directory?( entry ) || !File.directory?( artifact_path )
+
+    # Fill a temporary directory and rename it into place so no partial entry is ever restored
+    temp = "#{entry}.#{Process.pid}.tmp"
+    FileUtils.rm_rf( temp )
+    FileUtils.mkdir_p( temp )
+    FileUtils.cp_r( File.join( artifact_path, '.' ), temp )
+
+    begin
+      File.rename( temp, entry )
+    rescue SystemCallError
+      # Another build cached the same artifacts first
+      FileUtils.rm_rf( temp )
+    end
+
+    @ceedling[:loginator].lazy( Verbosity::OBNOXIOUS ) { "Cached artifacts of dependency #{blob[:name]} in #{entry}" }
+  end
+
+  def absolute_path(path)
+    return File.expand_path( path, @project_root )
+  end
+
   def validate_fetch_tools(blob)
     return if blob[:fetch].nil? || blob[:fetch][:method].nil?
 
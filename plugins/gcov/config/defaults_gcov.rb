@@ -72,6 +72,7 @@ DEFAULT_GCOV_REPORT_TOOL = {
     "-r".freeze,            # --relative-only: skip files with absolute paths (excludes system headers)
     "-s \"${2}\"".freeze,   # --source-prefix: strip project root so -r accepts project sources recorded with absolute paths
     "-x".freeze,            # --hash-filenames: unique .gcov name per source path, no collision for same-basename files in different directories
+    "--stdout".freeze,      # Write .gcov content to $stdout (rather than the working directory) for Ceedling to store beside the .gcno file
     "${1}".freeze           # .gcno filepath
     ].freeze
   }
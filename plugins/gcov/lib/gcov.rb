@@ -5,6 +5,7 @@
 #   SPDX-License-Identifier: MIT
 # =========================================================================
 
+require 'digest'
 require 'ceedling/plugins/plugin'
 require 'ceedling/constants'
 require 'ceedling/exceptions'
@@ -59,9 +60,17 @@ class Gcov < Plugin
     @file_wrapper = @ceedling[:file_wrapper]
     @tool_executor = @ceedling[:tool_executor]
     @plugin_manager = @ceedling[:plugin_manager]
+    @batchinator = @ceedling[:batchinator]
 
     @mutex = Mutex.new()
 
+    # ReportGenerator's .gcov files may be generated per test as the test suite runs
+    # (only worthwhile if reports are generated automatically at the end of the build)
+    @per_test_reportinator = nil
+    if automatic_reporting_enabled? && @project_config[:gcov_report_generator][:process_during_tests]
+      @per_test_reportinator = @reportinators.find { |reportinator| reportinator.is_a?( ReportGeneratorReportinator ) }
+    end
+
     # Validate MC/DC configuration against GCC version (only incurs gcc --version when :mcdc: TRUE)
     if @project_config[:gcov_mcdc]
       gcc_version = get_gcc_version()
@@ -132,20 +141,45 @@ class Gcov < Plugin
         return
       end
 
-      untested_sources.each do |filepath|
-        filename = File.basename(filepath)
+      search_paths = @configurator.collection_paths_include
+      flags        = @flaginator.flag_down( context:GCOV_SYM, operation:OPERATION_COMPILE_SYM )
+      defines      = @defineinator.defines( subkey:GCOV_SYM )
+
+      # Everything but the source file that determines a coverage object's compilation
+      command_key = [TOOLS_GCOV_COMPILER, search_paths, flags, defines, @project_config[:gcov_mcdc]].inspect
+
+      skipped = 0
+
+      # Compile in parallel across the compile thread pool
+      @batchinator.exec( workload: :compile, things: untested_sources ) do |filepath|
+        filename     = File.basename(filepath)
+        object       = @file_path_utils.form_test_object_filepath( filepath, context:GCOV_SYM )
+        dependencies = @file_path_utils.form_test_dependencies_filepath( filepath, context:GCOV_SYM )
+        fingerprint  = object + EXTENSION_GCOV_FINGERPRINT
+
+        # Skip a source whose coverage object was built from the same source, header, and
+        # command line contents as now
+        if untested_object_current?( object, fingerprint, dependencies, command_key )
+          @mutex.synchronize { skipped += 1 }
+          @loginator.lazy( Verbosity::OBNOXIOUS ) { "Coverage object for untested '#{filename}' is up to date" }
+          next
+        end
+
         begin
           @generator.generate_object_file_c(
             tool:         TOOLS_GCOV_COMPILER,
             module_name:  filename.ext(),
             context:      GCOV_SYM,
             source:       filepath,
-            object:       @file_path_utils.form_test_object_filepath( filepath, context:GCOV_SYM ),
-            search_paths: @configurator.collection_paths_include,
-            flags:        @flaginator.flag_down( context:GCOV_SYM, operation:OPERATION_COMPILE_SYM ),
-            defines:      @defineinator.defines( subkey:GCOV_SYM ),
-            dependencies: @file_path_utils.form_test_dependencies_filepath( filepath, context:GCOV_SYM )
+            object:       object,
+            search_paths: search_paths,
+            flags:        flags,
+            defines:      defines,
+            dependencies: dependencies
           )
+
+          digest = untested_object_digest( dependencies, command_key )
+          @file_wrapper.write( fingerprint, digest ) if !digest.nil?
         rescue ShellException => ex
           # Log actionable guidance then re-raise immediately (omitted when `guidance` is false)
           if guidance
@@ -162,6 +196,10 @@ class Gcov < Plugin
           raise ex
         end
       end
+
+      if skipped > 0
+        @loginator.log( "Skipped #{skipped} untested source(s) with up-to-date coverage objects." )
+      end
     end
   end
 
@@ -199,6 +237,12 @@ class Gcov < Plugin
         @result_list << arg_hash[:result_file]
       end
     end
+
+    # Process this test's coverage results while remaining tests run
+    # (the test executable's .gcda files are complete once it has exited)
+    if (arg_hash[:context] == GCOV_SYM) && !@per_test_reportinator.nil?
+      @per_test_reportinator.process_test_coverage( File.dirname( arg_hash[:executable] ) )
+    end
   end
 
   # `Plugin` build step hook
@@ -304,6 +348,37 @@ class Gcov < Plugin
     end
   end
 
+  # True if a coverage object and its notes file exist and its recorded fingerprint
+  # matches the current contents of everything it was compiled from
+  def untested_object_current?(object, fingerprint, dependencies, command_key)
+    return false if !File.exist?( object ) || !File.exist?( object.ext( EXTENSION_GCNO ) )
+    return false if !File.exist?( fingerprint )
+
+    digest = untested_object_digest( dependencies, command_key )
+    return !digest.nil? && (File.read( fingerprint ) == digest)
+  end
+
+  # Digest of a compilation's command line inputs and the contents of every file its
+  # make-style dependencies file lists (the source and all headers it includes).
+  # nil if the dependencies file or any file it lists is missing.
+  def untested_object_digest(dependencies, command_key)
+    return nil if !File.exist?( dependencies )
+
+    # `object: source header1 header2 \` (continuation lines joined)
+    rule = File.read( dependencies ).gsub( /\\\r?\n/, ' ' )
+    files = rule.sub( /\A.*?:(\s|\z)/, '' ).split
+
+    digest = Digest::SHA256.new
+    digest << command_key
+
+    files.each do |filepath|
+      return nil if !File.exist?( filepath )
+      digest << filepath << "\0" << File.binread( filepath )
+    end
+
+    return digest.hexdigest
+  end
+
   # All project sources minus every source any test references — works whether that
   # mapping came from a full test build (gcov:all) or a sources-only pass (gcov:untested_sources).
   def collect_untested_sources(sources)
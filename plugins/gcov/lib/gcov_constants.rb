@@ -7,6 +7,8 @@
 
 EXTENSION_GCNO                  = '.gcno'.freeze
 EXTENSION_GCOV                  = '.gcov'.freeze
+# Untested source coverage object fingerprint (digest of its compilation inputs)
+EXTENSION_GCOV_FINGERPRINT      = '.fingerprint'.freeze
 
 GCOV_ROOT_NAME                  = 'gcov'.freeze
 GCOV_TASK_ROOT                  = GCOV_ROOT_NAME + ':'
@@ -29,6 +31,9 @@ GCOV_GCOVR_ARTIFACTS_FILE_COBERTURA   = File.join(GCOV_GCOVR_ARTIFACTS_PATH, "Gc
 GCOV_GCOVR_ARTIFACTS_FILE_SONARQUBE   = File.join(GCOV_GCOVR_ARTIFACTS_PATH, "GcovCoverageSonarQube.xml")
 GCOV_GCOVR_ARTIFACTS_FILE_JSON        = File.join(GCOV_GCOVR_ARTIFACTS_PATH, "GcovCoverage.json")
 
+# Intermediate gcovr coverage data from which further reports are derived without reprocessing coverage results
+GCOV_GCOVR_TRACEFILE                  = File.join(GCOV_BUILD_PATH, "GcovrTracefile.json")
+
 TOOL_COLLECTION_GCOV_TASKS = {
   :test_compiler  => TOOLS_GCOV_COMPILER,
   :test_assembler => TOOLS_TEST_ASSEMBLER,
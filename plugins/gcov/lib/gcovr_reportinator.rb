@@ -61,16 +61,14 @@ class GcovrReportinator < GcovReportinator
 
     @loginator.log(@reportinator.generate_heading("Running Gcovr Coverage Reports"))
 
-    # gcovr 4.2+ can produce all report formats in one invocation;
+    # gcovr 4.2+ can produce all report formats from a single pass over coverage data;
     # earlier versions require a separate call for each format.
     if min_version?(@gcovr_version, 4, 2)
       generate_reports_modern(gcovr_opts, args_common, exception_on_fail, opts)
     else
       generate_reports_legacy(gcovr_opts, args_common, exception_on_fail, opts)
+      generate_text_report(opts, args_common, exception_on_fail) if report_enabled?(opts, ReportTypes::TEXT)
     end
-
-    # Text report is always a standalone gcovr invocation regardless of version.
-    generate_text_report(opts, args_common, exception_on_fail) if report_enabled?(opts, ReportTypes::TEXT)
   end
 
   ### Private ###
@@ -188,22 +186,35 @@ class GcovrReportinator < GcovReportinator
 
     # Determine if the gcovr JSON report is enabled. Defaults to disabled.
     if report_enabled?( opts, ReportTypes::JSON )
-      # Determine the JSON report file name.
-      artifacts_file_json = GCOV_GCOVR_ARTIFACTS_FILE_JSON
-      if !(gcovr_opts[:json_artifact_filename].nil?)
-        artifacts_file_json = File.join(GCOV_GCOVR_ARTIFACTS_PATH, gcovr_opts[:json_artifact_filename])
-      end
-
       args += "--json-pretty " if gcovr_opts[:json_pretty] && !config_file_in_use?(gcovr_opts)
-      # Note: In gcovr 4.2, the JSON report is output only when the --output option is specified.
-      # Hopefully we can remove --output after a future gcovr release.
-      args += "--json #{use_output_option ? "--output " : ""} \"#{artifacts_file_json}\" "
+      args += args_builder_json_file(json_artifact_filepath(gcovr_opts), use_output_option)
     end
 
     return args
   end
 
 
+  # Build the gcovr arguments writing a JSON report (also usable as a tracefile) to filepath.
+  def args_builder_json_file(filepath, use_output_option)
+    # Note: In gcovr 4.2, the JSON report is output only when the --output option is specified.
+    # Hopefully we can remove --output after a future gcovr release.
+    return "--json #{use_output_option ? "--output " : ""} \"#{filepath}\" "
+  end
+
+
+  # Determine the JSON report file name.
+  def json_artifact_filepath(gcovr_opts)
+    return GCOV_GCOVR_ARTIFACTS_FILE_JSON if gcovr_opts[:json_artifact_filename].nil?
+    return File.join(GCOV_GCOVR_ARTIFACTS_PATH, gcovr_opts[:json_artifact_filename])
+  end
+
+
+  # Determine the text report file name.
+  def text_artifact_filepath(gcovr_opts)
+    return File.join(GCOV_GCOVR_ARTIFACTS_PATH, gcovr_opts[:text_artifact_filename] || 'coverage.txt')
+  end
+
+
   # Build the gcovr HTML report generation arguments.
   def args_builder_html(opts, use_output_option=false)
     gcovr_opts = collect_gcovr_opts(opts)
@@ -245,16 +256,16 @@ class GcovrReportinator < GcovReportinator
 
 
   # Generate a gcovr text report.
+  # With a tracefile, the report is derived from that coverage data rather than
+  # gcovr processing the build's coverage results again.
   # @summary is set by run_gcovr when :print_summary is enabled.
-  def generate_text_report(opts, args_common, boom)
+  def generate_text_report(opts, args_common, boom, tracefile:nil)
     gcovr_opts = collect_gcovr_opts(opts)
     args_text = ""
     message_text = "Generating a text coverage report"
 
-    filename = gcovr_opts[:text_artifact_filename] || 'coverage.txt'
-
-    artifacts_file_txt = File.join(GCOV_GCOVR_ARTIFACTS_PATH, filename)
-    args_text += "--output \"#{artifacts_file_txt}\" "
+    args_text += "--add-tracefile \"#{tracefile}\" " unless tracefile.nil?
+    args_text += "--output \"#{text_artifact_filepath(gcovr_opts)}\" "
     message_text += " in '#{GCOV_GCOVR_ARTIFACTS_PATH}'"
 
     msg = @reportinator.generate_progress(message_text)
@@ -267,10 +278,14 @@ class GcovrReportinator < GcovReportinator
   # gcovr 4.2+ supports all output formats in a single invocation.
   # Accumulate per-format args and track which formats are active for progress logging.
   # As required by gcovr 4.2, --html arguments must be appended last.
+  # The text report joins the same invocation with gcovr 5.0+ (--txt). Before that, it is
+  # derived afterward from this invocation's JSON tracefile, so coverage data is only
+  # ever processed once.
   # @summary is set by run_gcovr when :print_summary is enabled.
   def generate_reports_modern(gcovr_opts, args_common, exception_on_fail, opts)
-    reports = []
-    args    = args_common
+    reports   = []
+    args      = args_common
+    tracefile = nil
 
     args += (_args = args_builder_cobertura(opts, false))
     reports << "Cobertura XML" unless _args.empty?
@@ -282,8 +297,26 @@ class GcovrReportinator < GcovReportinator
     reports << "JSON" unless _args.empty?
 
     # --html must be last (gcovr 4.2 requirement)
-    args += (_args = args_builder_html(opts, false))
-    reports << "HTML" unless _args.empty?
+    args_html = args_builder_html(opts, false)
+    reports << "HTML" unless args_html.empty?
+
+    text_enabled = report_enabled?(opts, ReportTypes::TEXT)
+
+    if text_enabled && min_version?(@gcovr_version, 5, 0)
+      args += "--txt \"#{text_artifact_filepath(gcovr_opts)}\" "
+      reports << "text"
+      text_enabled = false
+    elsif text_enabled && (args != args_common || !args_html.empty?)
+      # A JSON report doubles as the tracefile; otherwise write one to the build directory
+      if report_enabled?(opts, ReportTypes::JSON)
+        tracefile = json_artifact_filepath(gcovr_opts)
+      else
+        tracefile = GCOV_GCOVR_TRACEFILE
+        args += args_builder_json_file(tracefile, true)
+      end
+    end
+
+    args += args_html
 
     reports.each do |report|
       @loginator.log(
@@ -293,9 +326,9 @@ class GcovrReportinator < GcovReportinator
     end
 
     # Skip the gcovr call entirely when no format added arguments.
-    return if args == args_common
+    run_gcovr(gcovr_opts, args, exception_on_fail) if args != args_common
 
-    run_gcovr(gcovr_opts, args, exception_on_fail)
+    generate_text_report(opts, args_common, exception_on_fail, tracefile: tracefile) if text_enabled
   end
 
 
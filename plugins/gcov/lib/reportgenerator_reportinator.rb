@@ -6,6 +6,8 @@
 # =========================================================================
 
 require 'benchmark'
+require 'digest'
+require 'set'
 require 'ceedling/constants'
 require 'ceedling/exceptions'
 require 'ceedling/file_path_utils'
@@ -46,8 +48,26 @@ class ReportGeneratorReportinator < GcovReportinator
     @configurator  = @ceedling[:configurator]
     @batchinator   = @ceedling[:batchinator]
 
-    # Mutex that serializes each gcov subprocess + rename pair (see run_gcov).
+    # Mutex that serializes each gcov subprocess + rename pair of a `gcov` tool
+    # configured to write .gcov files into the working directory (see run_gcov).
     @gcov_cwd_mutex = Mutex.new
+
+    # .gcno directories already processed per test as the test suite ran (see process_test_coverage)
+    @processed_gcno_dirs = Set.new
+    @processed_lock = Mutex.new
+  end
+
+
+  # Run gcov on the .gcno files of a single test's build output directory as soon as its
+  # test executable has run, overlapping coverage processing with the remaining test runs.
+  # generate_reports() later skips directories already processed here.
+  def process_test_coverage(gcno_dir)
+    files = gcno_files( gcno_dir, gcno_exclude_regex( @config[REPORT_GENERATOR_SETTING_PREFIX.to_sym] ) )
+    source_prefix = Dir.pwd + File::SEPARATOR
+
+    files.each { |gcno_filepath| run_gcov(gcno_filepath, source_prefix) }
+
+    @processed_lock.synchronize { @processed_gcno_dirs << gcno_dir }
   end
 
 
@@ -60,8 +80,7 @@ class ReportGeneratorReportinator < GcovReportinator
 
       log_report_intentions(opts)
 
-      gcno_exclude_regex = build_gcno_exclude_regex(rg_opts)
-      generate_gcov_files(gcno_exclude_regex)
+      generate_gcov_files( gcno_exclude_regex(rg_opts) )
       shell_result = run_reportgenerator(opts, rg_opts)
     end
 
@@ -99,6 +118,9 @@ class ReportGeneratorReportinator < GcovReportinator
 
   REPORT_GENERATOR_SETTING_PREFIX = "gcov_report_generator"
 
+  # `gcov` option to write .gcov content to $stdout rather than files in the working directory
+  GCOV_STDOUT_OPTION = /(^|\s)(--stdout|-t)(\s|$)/
+
   # Map configured report types to ReportGenerator names, silently skipping unknowns.
   # Returns an array used to build both the -reporttypes: value and the report count.
   def build_report_types(opts)
@@ -160,6 +182,16 @@ class ReportGeneratorReportinator < GcovReportinator
   end
 
 
+  # Memoized (rg_opts[:gcov_exclude] is fixed for the build); shared by per-test
+  # processing and report generation.
+  def gcno_exclude_regex(rg_opts)
+    @processed_lock.synchronize do
+      @gcno_exclude_regex = build_gcno_exclude_regex(rg_opts) if !defined?(@gcno_exclude_regex)
+      return @gcno_exclude_regex
+    end
+  end
+
+
   # Build a Regexp that matches .gcno filepaths to be excluded from gcov processing,
   # combining user-specified patterns with internally-generated ones.
   # Returns nil when empty.
@@ -193,8 +225,9 @@ class ReportGeneratorReportinator < GcovReportinator
 
 
   # Run gcov on every .gcno file found beneath GCOV_BUILD_OUTPUT_PATH, skipping those
-  # that match gcno_exclude_regex. Within each directory, non-partial source files are
-  # processed before their partial counterparts.
+  # that match gcno_exclude_regex and directories already processed per test.
+  # Within each directory, non-partial source files are processed before their partial
+  # counterparts.
   def generate_gcov_files(gcno_exclude_regex)
     source_prefix = Dir.pwd + File::SEPARATOR
 
@@ -208,18 +241,13 @@ class ReportGeneratorReportinator < GcovReportinator
       .uniq
       .sort
 
+    processed = @processed_lock.synchronize { @processed_gcno_dirs.dup }
+
     # Pre-compute the sorted, filtered file list for each dir before dispatching.
     # filter_map drops empty dirs so Batchinator never queues no-op work items.
     work_items = gcno_dirs.filter_map do |gcno_dir|
-      files = Dir.glob(File.join(gcno_dir, "*#{EXTENSION_GCNO}"))
-        .reject { |f| gcno_exclude_regex && f =~ gcno_exclude_regex }
-        # Sort to process non-partial source files before their partial counterparts.
-        # Processing the coverage compiled version of the original source creates .gcov
-        # files for more than the partial does (primarily header files),
-        # but the .gcov file for the partial contains the correct coverage information.
-        # So, we must process the original source first and then overwrite some of it
-        # what it generates with partial .gcov generation.
-        .sort_by { |f| File.basename(f).start_with?(PARTIAL_FILENAME_PREFIX) ? 1 : 0 }
+      next nil if processed.include?( gcno_dir )
+      files = gcno_files( gcno_dir, gcno_exclude_regex )
       files.empty? ? nil : { gcno_dir: gcno_dir, gcno_files: files }
     end
 
@@ -231,6 +259,20 @@ class ReportGeneratorReportinator < GcovReportinator
   end
 
 
+  # The .gcno files directly within gcno_dir not matching gcno_exclude_regex, sorted to
+  # process non-partial source files before their partial counterparts.
+  # Processing the coverage compiled version of the original source creates .gcov
+  # files for more than the partial does (primarily header files),
+  # but the .gcov file for the partial contains the correct coverage information.
+  # So, we must process the original source first and then overwrite some of it
+  # what it generates with partial .gcov generation.
+  def gcno_files(gcno_dir, gcno_exclude_regex)
+    Dir.glob(File.join(gcno_dir, "*#{EXTENSION_GCNO}"))
+      .reject { |f| gcno_exclude_regex && f =~ gcno_exclude_regex }
+      .sort_by { |f| File.basename(f).start_with?(PARTIAL_FILENAME_PREFIX) ? 1 : 0 }
+  end
+
+
   # Run ReportGenerator if .gcov files are present. Returns the shell result, or nil
   # with a complaint log if no .gcov files were produced by the gcov step.
   def run_reportgenerator(opts, rg_opts)
@@ -294,10 +336,88 @@ class ReportGeneratorReportinator < GcovReportinator
   # source_prefix is the absolute project root — passed as -s to strip absolute #line
   # directive paths to relative so gcov's -r filter accepts project sources while
   # system headers (which don't match the prefix) remain excluded.
-  # gcov writes .gcov files into the CWD; this method moves each one to the same
-  # directory as the .gcno file so coverage data stays co-located with its build output.
+  # The default `gcov` tool writes its .gcov content to $stdout (--stdout); this method
+  # splits that content per source file and writes each .gcov file into the same
+  # directory as the .gcno file, so coverage data stays co-located with its build output.
+  # Nothing is written to the shared working directory, so any number of gcov runs may
+  # proceed concurrently.
   # Non-fatal: gcov exits non-zero for a missing .gcda (untested source); continue execution.
   def run_gcov(gcno_filepath, source_prefix)
+    command = @tool_executor.build_command_line(TOOLS_GCOV_REPORT, [], "\"#{gcno_filepath}\"", source_prefix)
+    command[:options][:boom] = false
+
+    # A `gcov` tool configured without --stdout writes .gcov files into the working
+    # directory instead -- see run_gcov_in_cwd()
+    return run_gcov_in_cwd(command, gcno_filepath) if (command[:line] !~ GCOV_STDOUT_OPTION)
+
+    # An older `gcov` lacking --stdout already rejected it -- run without it
+    return run_gcov_in_cwd(without_stdout_option(command), gcno_filepath) if @gcov_stdout_unsupported
+
+    shell_result = @tool_executor.exec( command )
+
+    # Each source file's content begins with its `-:    0:Source:<filepath>` line
+    sections = split_gcov_stdout( shell_result[:stdout] )
+
+    if sections.empty? && (shell_result[:output] =~ /(unrecognized|invalid|unknown) option/i)
+      @gcov_stdout_unsupported = true
+      return run_gcov_in_cwd(without_stdout_option(command), gcno_filepath)
+    end
+
+    log_gcov_failure(gcno_filepath, shell_result)
+
+    gcno_dir = File.dirname(gcno_filepath)
+
+    sections.each do |source, content|
+      File.write( File.join(gcno_dir, gcov_filename(source)), content )
+    end
+
+    return shell_result
+  end
+
+
+  # Name of the .gcov file written for a source file split from `gcov --stdout` output.
+  # ReportGenerator reads source paths from within .gcov files, so any name will do that is
+  # unique per source path (no collision for same-basename files in different directories) and
+  # stable from one build to the next (each build overwrites the last).
+  def gcov_filename(source)
+    return "#{File.basename(source)}###{Digest::MD5.hexdigest(source)}#{EXTENSION_GCOV}"
+  end
+
+
+  # Splits `gcov --stdout` output into [source filepath, .gcov file content] pairs.
+  def split_gcov_stdout(output)
+    sections = []
+
+    output.each_line do |line|
+      if (line =~ /^\s*-:\s*0:Source:(.+)$/)
+        sections << [$1.strip, line.dup]
+      elsif !sections.empty?
+        sections.last[1] << line
+      end
+    end
+
+    return sections
+  end
+
+
+  def without_stdout_option(command)
+    return command.merge( line: command[:line].sub( GCOV_STDOUT_OPTION, ' ' ) )
+  end
+
+
+  def log_gcov_failure(gcno_filepath, shell_result)
+    return if shell_result[:exit_code] == 0
+
+    @loginator.log(
+      "gcov could not process #{gcno_filepath} (exit #{shell_result[:exit_code]})",
+      Verbosity::COMPLAIN
+    )
+  end
+
+
+  # gcov writes .gcov files into the CWD; this method moves each one to the same
+  # directory as the .gcno file so coverage data stays co-located with its build output.
+  def run_gcov_in_cwd(command, gcno_filepath)
     # gcov must run in the same working directory used during compilation so it can
     # locate the .gcda data files produced at test-fixture execution time. However,
     # parallel test builds share source files (e.g. src/utils.c may be compiled into
@@ -308,20 +428,11 @@ class ReportGeneratorReportinator < GcovReportinator
     # produce the same output filename). The second write clobbers the first before the
     # rename to each test's build sub-directory can complete, silently losing coverage
     # data. Serializing the exec+rename pair with a mutex eliminates the race at the cost
-    # of sequentializing only this step; the per-dir glob/filter/sort work in
-    # generate_gcov_files still runs in parallel across the Batchinator thread pool.
+    # of sequentializing only this step.
     @gcov_cwd_mutex.synchronize do
-      command = @tool_executor.build_command_line(TOOLS_GCOV_REPORT, [], "\"#{gcno_filepath}\"", source_prefix)
-      command[:options][:boom] = false
-
       shell_result = @tool_executor.exec( command )
 
-      if shell_result[:exit_code] != 0
-        @loginator.log(
-          "gcov could not process #{gcno_filepath} (exit #{shell_result[:exit_code]})",
-          Verbosity::COMPLAIN
-        )
-      end
+      log_gcov_failure(gcno_filepath, shell_result)
 
       # gcov logs each file it creates, e.g.: Creating 'a1b2c3d4.gcov'
       # Scan for a space followed by any non-whitespace characters ending in EXTENSION_GCOV,
@@ -0,0 +1,200 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+##
+## Build benchmarks of a synthetic project with per-stage timings and regression checks.
+##
+## Each run builds the generated project three ways:
+##  - cold:  `clobber test:all`
+##  - warm:  `test:all` after touching one source file
+##  - no-op: `test:all` with nothing changed
+##
+## Stage timings come from the `stage` events of a JSON log of each build. The median of
+## all runs is written as JSON and, given a baseline (an earlier results file), compared
+## with it. Exits with 1 if any measure regressed beyond the tolerance.
+##
+## Usage: ruby spec/manual/benchmark/benchmark.rb --help
+##
+
+require 'optparse'
+require 'json'
+require 'open3'
+require 'tmpdir'
+require 'fileutils'
+require_relative 'project_generator'
+
+REPO_ROOT = File.expand_path( File.join( __dir__, '..', '..', '..' ) )
+
+SCENARIOS = {
+  'cold'  => 'clobber test:all',
+  'warm'  => 'test:all',
+  'no-op' => 'test:all'
+}
+
+options = {
+  :tests     => 20,
+  :mocks     => 2,
+  :depth     => 4,
+  :partials  => 0,
+  :runs      => 3,
+  :workdir   => File.join( Dir.tmpdir, 'ceedling_benchmark' ),
+  :output    => 'benchmark_results.json',
+  :baseline  => nil,
+  :tolerance => 10.0,
+  :min_delta => 0.1,
+  :ceedling  => "ruby #{File.join( REPO_ROOT, 'bin', 'ceedling' )}"
+}
+
+OptionParser.new do |parser|
+  parser.banner = "Usage: ruby #{File.basename( __FILE__ )} [options]"
+
+  parser.on( '--tests N', Integer, "Test files (default #{options[:tests]})" ) {|value| options[:tests] = value }
+  parser.on( '--mocks M', Integer, "Mocks per test (default #{options[:mocks]})" ) {|value| options[:mocks] = value }
+  parser.on( '--depth D', Integer, "Depth of each module's header include chain (default #{options[:depth]})" ) {|value| options[:depth] = value }
+  parser.on( '--partials P', Integer, "Tests using Partials (default #{options[:partials]})" ) {|value| options[:partials] = value }
+  parser.on( '--runs R', Integer, "Runs of each scenario; medians are reported (default #{options[:runs]})" ) {|value| options[:runs] = value }
+  parser.on( '--workdir DIR', "Where the synthetic project is generated (default #{options[:workdir]})" ) {|value| options[:workdir] = value }
+  parser.on( '--output FILE', "Results JSON file (default #{options[:output]})" ) {|value| options[:output] = value }
+  parser.on( '--baseline FILE', 'Earlier results JSON file to compare against' ) {|value| options[:baseline] = value }
+  parser.on( '--tolerance PCT', Float, "Slowdown (percent) tolerated before a regression (default #{options[:tolerance]})" ) {|value| options[:tolerance] = value }
+  parser.on( '--min-delta SECS', Float, "Slowdown (seconds) always tolerated (default #{options[:min_delta]})" ) {|value| options[:min_delta] = value }
+  parser.on( '--ceedling CMD', "Command running Ceedling (default `#{options[:ceedling]}`)" ) {|value| options[:ceedling] = value }
+end.parse!
+
+def median(values)
+  return nil if values.empty?
+  sorted = values.sort
+  middle = sorted.size / 2
+  return sorted.size.odd? ? sorted[middle] : ((sorted[middle - 1] + sorted[middle]) / 2.0)
+end
+
+# Wall time plus the summed durations of each pipeline stage (over all build contexts) and tools
+def build(command, project, logfile)
+  FileUtils.rm_f( logfile )
+
+  started = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+  output, status = Open3.capture2e( "#{command} --log --logfile=#{logfile} --log-format=json", :chdir => project )
+  wall = Process.clock_gettime( Process::CLOCK_MONOTONIC ) - started
+
+  raise "Build `#{command}` failed:\n#{output}" if !status.success?
+
+  measures = { 'wall' => wall, 'tools' => 0.0, 'stages' => Hash.new( 0.0 ) }
+
+  File.foreach( logfile ) do |line|
+    entry = JSON.parse( line )
+    case entry['event']
+    when 'stage' then measures['stages'][entry['name']] += entry['duration']
+    when 'tool'  then measures['tools'] += entry['duration']
+    end
+  end
+
+  return measures
+end
+
+def summarize(samples)
+  stages = samples.map {|sample| sample['stages'].keys}.flatten.uniq
+
+  return {
+    'wall'   => median( samples.map {|sample| sample['wall']} ).round( 3 ),
+    'tools'  => median( samples.map {|sample| sample['tools']} ).round( 3 ),
+    'stages' => stages.to_h {|stage| [stage, median( samples.map {|sample| sample['stages'][stage]} ).round( 3 )]}
+  }
+end
+
+# [scenario, measure, baseline, current] of every measure slower than tolerated
+def regressions(baseline, results, tolerance:, min_delta:)
+  found = []
+
+  results['scenarios'].each do |scenario, current|
+    previous = baseline['scenarios'][scenario]
+    next if previous.nil?
+
+    measures = [['wall', previous['wall'], current['wall']], ['tools', previous['tools'], current['tools']]]
+    current['stages'].each {|stage, duration| measures << [stage, previous['stages'][stage], duration]}
+
+    measures.each do |measure, before, after|
+      next if before.nil?
+      slower = after - before
+      found << [scenario, measure, before, after] if (slower > min_delta) and (slower > (before * tolerance / 100.0))
+    end
+  end
+
+  return found
+end
+
+project = File.join( options[:workdir], 'project' )
+logs    = File.join( options[:workdir], 'logs' )
+FileUtils.mkdir_p( logs )
+
+generator = BenchmarkProjectGenerator.new(
+  root:           project,
+  tests:          options[:tests],
+  mocks:          options[:mocks],
+  depth:          options[:depth],
+  partials:       options[:partials],
+  which_ceedling: REPO_ROOT
+)
+generator.generate()
+
+samples = SCENARIOS.keys.to_h {|scenario| [scenario, []]}
+
+options[:runs].times do |run|
+  puts "Run #{run + 1} of #{options[:runs]}..."
+
+  SCENARIOS.each do |scenario, tasks|
+    FileUtils.touch( generator.touch_source ) if scenario == 'warm'
+
+    logfile = File.join( logs, "#{scenario}_#{run + 1}.jsonl" )
+    samples[scenario] << build( "#{options[:ceedling]} #{tasks}", project, logfile )
+    puts "  #{scenario.ljust( 6 )} #{samples[scenario].last['wall'].round( 2 )}s"
+  end
+end
+
+revision, _ = Open3.capture2( 'git', 'rev-parse', '--short', 'HEAD', :chdir => REPO_ROOT )
+
+results = {
+  'revision'  => revision.strip,
+  'ruby'      => RUBY_VERSION,
+  'platform'  => RUBY_PLATFORM,
+  'timestamp' => Time.now.utc.strftime( '%Y-%m-%dT%H:%M:%SZ' ),
+  'project'   => options.slice( :tests, :mocks, :depth, :partials ).transform_keys( &:to_s ),
+  'runs'      => options[:runs],
+  'scenarios' => samples.transform_values {|scenario_samples| summarize( scenario_samples )}
+}
+
+File.write( options[:output], JSON.pretty_generate( results ) + "\n" )
+
+puts
+results['scenarios'].each do |scenario, measures|
+  puts "#{scenario}: #{measures['wall']}s wall, #{measures['tools']}s in tools"
+  measures['stages'].sort_by {|_, duration| -duration}.each do |stage, duration|
+    puts "  #{duration.to_s.rjust( 8 )}s  #{stage}"
+  end
+end
+puts "\nResults written to #{options[:output]}"
+
+exit( 0 ) if options[:baseline].nil?
+
+baseline = JSON.parse( File.read( options[:baseline] ) )
+
+if baseline['project'] != results['project']
+  puts "\nWARNING: Baseline project #{baseline['project']} differs from #{results['project']}"
+end
+
+found = regressions( baseline, results, tolerance: options[:tolerance], min_delta: options[:min_delta] )
+
+if found.empty?
+  puts "\nNo regressions against #{options[:baseline]} (#{baseline['revision']})"
+  exit( 0 )
+end
+
+puts "\nREGRESSIONS against #{options[:baseline]} (#{baseline['revision']}):"
+found.each do |scenario, measure, before, after|
+  change = (before > 0) ? " (+#{(((after - before) / before) * 100).round( 1 )}%)" : ''
+  puts "  #{scenario} / #{measure}: #{before}s -> #{after}s#{change}"
+end
+exit( 1 )
@@ -0,0 +1,194 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'fileutils'
+
+##
+## Synthetic Ceedling project of a given shape for benchmarking.
+##
+## Each of `tests` test files exercises its own module under test. Each module calls
+## `mocks` mocked dependency interfaces and includes a chain of `depth` headers, each
+## found in its own include search path. The first `partials` tests test their module's
+## `static` function through a Partial instead of its header.
+##
+class BenchmarkProjectGenerator
+
+  def initialize(root:, tests:, mocks:, depth:, partials:, which_ceedling:)
+    @root           = root
+    @tests          = tests
+    @mocks          = mocks
+    @depth          = depth
+    @partials       = [partials, tests].min
+    @which_ceedling = which_ceedling
+  end
+
+  def generate
+    FileUtils.rm_rf( @root )
+
+    write( 'project.yml', project_yml() )
+
+    @depth.times {|level| write( "inc/level_#{level}/level_#{level}.h", level_header( level ) ) }
+
+    @tests.times do |test|
+      @mocks.times {|mock| write( "src/deps/dep_#{test}_#{mock}.h", dependency_header( test, mock ) ) }
+      write( "src/module_#{test}.h", module_header( test ) )
+      write( "src/module_#{test}.c", module_source( test ) )
+      write( "test/test_module_#{test}.c", (test < @partials) ? partial_test_file( test ) : test_file( test ) )
+    end
+  end
+
+  # A source file to touch for an incremental (warm) build
+  def touch_source
+    return File.join( @root, 'src', 'module_0.c' )
+  end
+
+  ### Private ###
+
+  private
+
+  def write(filepath, contents)
+    filepath = File.join( @root, filepath )
+    FileUtils.mkdir_p( File.dirname( filepath ) )
+    File.write( filepath, contents )
+  end
+
+  def project_yml
+    return <<~YAML
+      ---
+      :project:
+        :name: "Benchmark (#{@tests} tests, #{@mocks} mocks per test, depth #{@depth}, #{@partials} partials)"
+        :which_ceedling: #{@which_ceedling}
+        :use_mocks: TRUE
+        :use_partials: #{@partials > 0 ? 'TRUE' : 'FALSE'}
+        :use_backtrace: :none
+        :build_root: build
+        :compile_threads: :auto
+        :test_threads: :auto
+
+      :paths:
+        :test:
+          - test/**
+        :source:
+          - src/**
+        :include:
+          - src/**
+          - inc/**
+
+      :plugins:
+        :enabled:
+          - report_tests_pretty_stdout
+    YAML
+  end
+
+  # level_0.h includes level_1.h includes ... -- LEVEL_0_VALUE is the chain's depth
+  def level_header(level)
+    guard = "LEVEL_#{level}_H"
+    last  = (level == @depth - 1)
+
+    return <<~C
+      #ifndef #{guard}
+      #define #{guard}
+
+      #{last ? '' : "#include \"level_#{level + 1}.h\""}
+
+      #define LEVEL_#{level}_VALUE (1#{last ? '' : " + LEVEL_#{level + 1}_VALUE"})
+
+      #endif // #{guard}
+    C
+  end
+
+  def dependency_header(test, mock)
+    guard = "DEP_#{test}_#{mock}_H"
+
+    return <<~C
+      #ifndef #{guard}
+      #define #{guard}
+
+      int dep_#{test}_#{mock}_get(void);
+      void dep_#{test}_#{mock}_set(int value);
+
+      #endif // #{guard}
+    C
+  end
+
+  def module_header(test)
+    guard = "MODULE_#{test}_H"
+
+    return <<~C
+      #ifndef #{guard}
+      #define #{guard}
+
+      int module_#{test}_run(void);
+
+      #endif // #{guard}
+    C
+  end
+
+  def module_source(test)
+    includes = @mocks.times.map {|mock| "#include \"dep_#{test}_#{mock}.h\""}
+    includes << '#include "level_0.h"' if @depth > 0
+
+    calls = @mocks.times.map {|mock| "  total += dep_#{test}_#{mock}_get();"}
+
+    return <<~C
+      #include "module_#{test}.h"
+      #{includes.join( "\n" )}
+
+      static int module_#{test}_double(int value)
+      {
+        return value * 2;
+      }
+
+      int module_#{test}_run(void)
+      {
+        int total = #{@depth > 0 ? 'LEVEL_0_VALUE' : '0'};
+      #{calls.join( "\n" )}
+        return module_#{test}_double( total );
+      }
+    C
+  end
+
+  def test_file(test)
+    includes = @mocks.times.map {|mock| "#include \"mock_dep_#{test}_#{mock}.h\""}
+    expects  = @mocks.times.map {|mock| "  dep_#{test}_#{mock}_get_ExpectAndReturn( 1 );"}
+
+    return <<~C
+      #include "unity.h"
+      #include "module_#{test}.h"
+      #{includes.join( "\n" )}
+
+      void setUp(void) {}
+      void tearDown(void) {}
+
+      void test_module_#{test}_sums_dependencies(void)
+      {
+      #{expects.join( "\n" )}
+        TEST_ASSERT_EQUAL_INT( 2 * (#{@depth} + #{@mocks}), module_#{test}_run() );
+      }
+    C
+  end
+
+  def partial_test_file(test)
+    includes = @mocks.times.map {|mock| "#include \"mock_dep_#{test}_#{mock}.h\""}
+
+    return <<~C
+      #include "unity.h"
+      #include "ceedling.h"
+      #include TEST_PARTIAL_PRIVATE_MODULE(module_#{test})
+      #{includes.join( "\n" )}
+
+      void setUp(void) {}
+      void tearDown(void) {}
+
+      void test_module_#{test}_doubles(void)
+      {
+        TEST_ASSERT_EQUAL_INT( 4, module_#{test}_double( 2 ) );
+      }
+    C
+  end
+
+end
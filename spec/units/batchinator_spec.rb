@@ -0,0 +1,75 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'ceedling/batchinator'
+require 'ceedling/profiler'
+require 'ceedling/explainer'
+require 'ceedling/exceptions'
+
+# Scoped to batch workloads and worker processes (`:ruby_workers`)
+describe Batchinator do
+  before(:each) do
+    @configurator = double('configurator')
+    allow(@configurator).to receive(:project_compile_threads).and_return(3)
+    allow(@configurator).to receive(:project_test_threads).and_return(1)
+    allow(@configurator).to receive(:project_ruby_workers).and_return(:processes)
+
+    @loginator = double('loginator').as_null_object
+    allow(@loginator).to receive(:with_fields) {|&block| block.call}
+    allow(@loginator).to receive(:capture) {|&block| [block.call, []]}
+
+    @batchinator = described_class.new(
+      {
+        :configurator => @configurator,
+        :loginator => @loginator,
+        :reportinator => double('reportinator').as_null_object,
+        :progress_renderer => double('progress_renderer').as_null_object,
+        :profiler => Profiler.new( {:loginator => @loginator, :file_wrapper => nil} ),
+        :explainer => Explainer.new( {:loginator => @loginator, :file_wrapper => nil} )
+      }
+    )
+  end
+
+  it "rejects an unrecognized workload" do
+    expect { @batchinator.exec( workload: :bogus, things: [1] ) {} }.to raise_error( NameError )
+  end
+
+  it "returns results in the order of things from threads" do
+    allow(@configurator).to receive(:project_ruby_workers).and_return(:threads)
+
+    results = @batchinator.exec( workload: :ruby, things: [3, 1, 2] ) {|n| sleep( n / 100.0 ); n * 10}
+    expect( results ).to eq [30, 10, 20]
+  end
+
+  context "with worker processes", :if => Process.respond_to?( :fork ) do
+    it "returns results in the order of things" do
+      results = @batchinator.exec( workload: :ruby, things: [3, 1, 2, 4] ) {|n| sleep( n / 100.0 ); [Process.pid, n * 10]}
+
+      expect( results.map(&:last) ).to eq [30, 10, 20, 40]
+      expect( results.map(&:first) ).not_to include( Process.pid )
+    end
+
+    it "passes hash entries to the block" do
+      results = @batchinator.exec( workload: :ruby, things: {'a' => 1, 'b' => 2} ) {|key, value| "#{key}#{value}"}
+      expect( results ).to eq ['a1', 'b2']
+    end
+
+    it "raises an item's exception in this process" do
+      expect {
+        @batchinator.exec( workload: :ruby, things: [1, 2, 3] ) {|n| raise CeedlingException.new( "Failed #{n}" ) if n == 2; n}
+      }.to raise_error( CeedlingException, 'Failed 2' )
+    end
+
+    it "raises if a result cannot be returned from a worker process" do
+      expect {
+        @batchinator.exec( workload: :ruby, things: [1, 2] ) {|n| proc { n }}
+      }.to raise_error( CeedlingException, /could not be returned from a worker process/ )
+    end
+  end
+
+end
@@ -0,0 +1,63 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'stringio'
+require 'build_client'
+
+describe BuildClient do
+
+  context "#socket_path" do
+    it "should default to a socket in the working directory" do
+      expect( BuildClient.socket_path( {} ) ).to eq( BuildClient::DEFAULT_SOCKET )
+    end
+
+    it "should prefer the socket environment variable" do
+      env = { BuildClient::SOCKET_ENV_VAR => '/tmp/ceedling.sock' }
+      expect( BuildClient.socket_path( env ) ).to eq( '/tmp/ceedling.sock' )
+    end
+  end
+
+  context "#write_frame / #read_frame" do
+    it "should round trip frames including binary payloads and empty payloads" do
+      io = StringIO.new( ''.b )
+
+      BuildClient.write_frame( io, BuildClient::FRAME_STDOUT, "Compiling Foo.c...\n" )
+      BuildClient.write_frame( io, BuildClient::FRAME_STDERR, "\xFF\x00\x1B[31m".b )
+      BuildClient.write_frame( io, BuildClient::FRAME_RELOAD, '' )
+      io.rewind
+
+      expect( BuildClient.read_frame( io ) ).to eq( [BuildClient::FRAME_STDOUT, "Compiling Foo.c...\n"] )
+      expect( BuildClient.read_frame( io ) ).to eq( [BuildClient::FRAME_STDERR, "\xFF\x00\x1B[31m".b] )
+      expect( BuildClient.read_frame( io ) ).to eq( [BuildClient::FRAME_RELOAD, ''] )
+      expect( BuildClient.read_frame( io ) ).to be_nil
+    end
+
+    it "should treat a truncated frame as a closed connection" do
+      io = StringIO.new( [BuildClient::FRAME_EXIT, 10].pack( 'a1N' ) + '1' )
+      expect( BuildClient.read_frame( io ) ).to be_nil
+    end
+  end
+
+  context "#forward" do
+    it "should never forward `server` commands" do
+      expect( File ).not_to receive( :exist? )
+      expect( BuildClient.forward( ['server', 'stop'], {} ) ).to be_nil
+    end
+
+    it "should not forward when disabled by environment variable" do
+      expect( File ).not_to receive( :exist? )
+      expect( BuildClient.forward( ['test:all'], { BuildClient::DISABLE_ENV_VAR => '1' } ) ).to be_nil
+    end
+
+    it "should not forward when no server socket exists" do
+      env = { BuildClient::SOCKET_ENV_VAR => '/does/not/exist.sock' }
+      expect( BuildClient.forward( ['test:all'], env ) ).to be_nil
+    end
+  end
+
+end
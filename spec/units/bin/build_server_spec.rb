@@ -0,0 +1,92 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'socket'
+require 'tmpdir'
+require 'fileutils'
+require 'build_server'
+
+describe BuildServer, :if => Process.respond_to?( :fork ) do
+  before(:each) do
+    @server = described_class.new(
+      {
+        :file_wrapper => nil,
+        :yaml_wrapper => nil,
+        :system_wrapper => nil,
+        :loginator => nil
+      }
+    )
+
+    @tmpdir = Dir.mktmpdir
+    bin = File.expand_path( File.join( File.dirname( __FILE__ ), '../../../bin' ) )
+
+    # Stands in for the launcher: forwards to any listening server exactly as bin/ceedling does
+    @script = File.join( @tmpdir, 'ceedling' )
+    File.write( @script, <<~SCRIPT )
+      $LOAD_PATH.unshift( '#{bin}' )
+      require 'build_client'
+      forwarded = BuildClient.forward( ARGV, ENV )
+      puts( "forwarded: \#{forwarded.inspect}" )
+      $stderr.puts( "argv: \#{ARGV.join( ' ' )}" )
+      exit!( 3 )
+    SCRIPT
+
+    # Another server listening on the socket the client's environment names
+    @socket = File.join( @tmpdir, 'server.sock' )
+    @other = UNIXServer.new( @socket )
+
+    @server.instance_variable_set( :@script, @script )
+    @server.instance_variable_set( :@listener, @other )
+  end
+
+  after(:each) do
+    @other.close if !@other.closed?
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  context "#build" do
+    it "runs a forwarded build in a worker that builds locally rather than forwarding again" do
+      # Answer any (mistakenly) forwarded build so a regression fails rather than hangs
+      answerer = Thread.new do
+        conn = @other.accept
+        conn.gets
+        BuildClient.write_frame( conn, BuildClient::FRAME_EXIT, '7' )
+        conn.close
+      rescue IOError
+        # Closed without a connection
+      end
+
+      request = {
+        'argv' => ['test:all'],
+        'cwd'  => @tmpdir,
+        'env'  => ENV.to_h.merge( BuildClient::SOCKET_ENV_VAR => @socket ).reject {|name, _| name == BuildClient::DISABLE_ENV_VAR}
+      }
+
+      server_end, client_end = UNIXSocket.pair
+      @server.send( :build, server_end, request )
+      server_end.close
+
+      frames = []
+      while (frame = BuildClient.read_frame( client_end ))
+        frames << frame
+      end
+      client_end.close
+
+      @other.close
+      answerer.join
+
+      stdout = frames.select {|type, _| type == BuildClient::FRAME_STDOUT}.map(&:last).join
+      stderr = frames.select {|type, _| type == BuildClient::FRAME_STDERR}.map(&:last).join
+
+      expect( stdout ).to eq "forwarded: nil\n"
+      expect( stderr ).to eq "argv: test:all\n"
+      expect( frames.last ).to eq [BuildClient::FRAME_EXIT, '3']
+    end
+  end
+
+end
@@ -8,10 +8,11 @@
 require 'spec_helper'
 require 'ceedling/config/configurator_setup'
 require 'ceedling/reportinator'
+require 'ceedling/defaults'
 
-# Only #validate_partials is covered here. The rest of ConfiguratorSetup has no unit spec
-# at all today (its closest sibling, #validate_threads, is untested too) -- this file scopes
-# itself to the new method rather than backfilling that existing gap.
+# Only #validate_partials, #validate_backtrace, #validate_test_build, #validate_release_build and #validate_jumbo_build are covered here. The rest of ConfiguratorSetup
+# has no unit spec at all today (its closest sibling, #validate_threads, is untested too) -- this
+# file scopes itself to newer methods rather than backfilling that existing gap.
 describe ConfiguratorSetup do
   before(:each) do
     @configurator_builder   = double('ConfiguratorBuilder')
@@ -58,4 +59,114 @@ describe ConfiguratorSetup do
       expect(@setup.validate_partials(config)).to be false
     end
   end
+
+  context "#validate_test_build" do
+    it "accepts each supported results format" do
+      [:json, :yaml].each do |format|
+        config = { test_build: { results_format: format, results_stdout_limit: 10000, jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: false } }
+        expect(@setup.validate_test_build(config)).to be true
+      end
+    end
+
+    it "rejects an unsupported results format" do
+      config = { test_build: { results_format: :xml, results_stdout_limit: 10000, jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: false } }
+      expect(@loginator).to receive(:log)
+        .with(/:test_build ↳ :results_format is ':xml' but must be one of \{:json, :yaml\}/, Verbosity::ERRORS)
+      expect(@setup.validate_test_build(config)).to be false
+    end
+
+    it "rejects a results stdout limit less than 1" do
+      config = { test_build: { results_format: :json, results_stdout_limit: 0, jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: false } }
+      expect(@loginator).to receive(:log)
+        .with(/:test_build ↳ :results_stdout_limit must be greater than 0/, Verbosity::ERRORS)
+      expect(@setup.validate_test_build(config)).to be false
+    end
+
+    it "rejects a non-integer results stdout limit" do
+      config = { test_build: { results_format: :json, results_stdout_limit: '100', jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: false } }
+      expect(@loginator).to receive(:log)
+        .with(/:test_build ↳ :results_stdout_limit is not an integer/, Verbosity::ERRORS)
+      expect(@setup.validate_test_build(config)).to be false
+    end
+
+    it "accepts each minimal search paths mode" do
+      [true, false].each do |mode|
+        config = { test_build: { results_format: :json, results_stdout_limit: 10000, jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: mode } }
+        expect(@setup.validate_test_build(config)).to be true
+      end
+    end
+
+    it "rejects an unsupported minimal search paths mode" do
+      config = { test_build: { results_format: :json, results_stdout_limit: 10000, jumbo_size: 0, jumbo_exclude: [], minimal_search_paths: :validate } }
+      expect(@loginator).to receive(:log)
+        .with(/:test_build ↳ :minimal_search_paths is 'validate' but must be one of \{true, false\}/, Verbosity::ERRORS)
+      expect(@setup.validate_test_build(config)).to be false
+    end
+  end
+
+  context "#validate_release_build" do
+    it "accepts each supported change detection" do
+      [:timestamp, :checksum].each do |detection|
+        config = { release_build: { change_detection: detection, jumbo_size: 0, jumbo_exclude: [] } }
+        expect(@setup.validate_release_build(config)).to be true
+      end
+    end
+
+    it "rejects an unsupported change detection" do
+      config = { release_build: { change_detection: :mtime, jumbo_size: 0, jumbo_exclude: [] } }
+      expect(@loginator).to receive(:log)
+        .with(/:release_build ↳ :change_detection is ':mtime' but must be one of \{:timestamp, :checksum\}/, Verbosity::ERRORS)
+      expect(@setup.validate_release_build(config)).to be false
+    end
+  end
+
+  context "#validate_backtrace" do
+    it "accepts the gdb tool arguments of the current layout" do
+      config = { project: { use_backtrace: :gdb }, tools: { test_backtrace_gdb: DEFAULT_TEST_BACKTRACE_GDB_TOOL } }
+      expect(@setup.validate_backtrace(config)).to be true
+    end
+
+    it "rejects a gdb tool that still takes a Unity filter argument" do
+      tool = { executable: 'gdb', arguments: ['-q', '--batch', '--eval-command run', '--command "${1}"', '--args', '${2}', '${3}'] }
+      config = { project: { use_backtrace: :gdb }, tools: { test_backtrace_gdb: tool } }
+      expect(@loginator).to receive(:log)
+        .with(/:tools ↳ :test_backtrace_gdb ↳ :arguments references \$\{3\}.+`--command "\$\{1\}"`/, Verbosity::ERRORS)
+      expect(@setup.validate_backtrace(config)).to be false
+    end
+
+    it "ignores the gdb tool unless gdb backtraces are enabled" do
+      tool = { executable: 'gdb', arguments: ['${3}'] }
+      config = { project: { use_backtrace: :simple }, tools: { test_backtrace_gdb: tool } }
+      expect(@setup.validate_backtrace(config)).to be true
+    end
+  end
+
+  context "#validate_jumbo_build" do
+    it "accepts a size of zero and a list of exclusions" do
+      config = { release_build: { jumbo_size: 0, jumbo_exclude: ['isr.c', 'src/legacy/**'] } }
+      expect(@setup.validate_jumbo_build(config, :release_build)).to be true
+    end
+
+    it "rejects a negative size" do
+      config = { test_build: { jumbo_size: -1, jumbo_exclude: [] } }
+      expect(@loginator).to receive(:log)
+        .with(/:test_build ↳ :jumbo_size must not be negative/, Verbosity::ERRORS)
+      expect(@setup.validate_jumbo_build(config, :test_build)).to be false
+    end
+
+    it "rejects a non-integer size" do
+      config = { release_build: { jumbo_size: '8', jumbo_exclude: [] } }
+      expect(@loginator).to receive(:log)
+        .with(/:release_build ↳ :jumbo_size is not an integer/, Verbosity::ERRORS)
+      expect(@setup.validate_jumbo_build(config, :release_build)).to be false
+    end
+
+    it "rejects exclusions that are not a list of strings" do
+      config = { release_build: { jumbo_size: 8, jumbo_exclude: 'isr.c' } }
+      expect(@loginator).to receive(:log)
+        .with(/:release_build ↳ :jumbo_exclude must be a list of filenames or filepath glob patterns/, Verbosity::ERRORS)
+      expect(@setup.validate_jumbo_build(config, :release_build)).to be false
+    end
+  end
+
 end
@@ -396,6 +396,30 @@ describe ConfigMatchinator do
       end
     end
 
+    context 'repeated matching' do
+      it 'matches a file once per section, context, and operation' do
+        hash = { :Foo => ['WHEN_FOO'] }
+
+        # One debug message for the non-match of the first lookup only
+        expect(@loginator).to receive(:lazy).once
+
+        2.times do
+          expect(@cm.matches?(hash: hash, filepath: 'test_Bar', section: :flags, context: :test, operation: :compile)).to eq([])
+        end
+      end
+
+      it 'returns a list the caller may modify without affecting later matches' do
+        result = @cm.matches?(hash: doc_hash, filepath: 'test_Main', section: :defines, context: :test)
+        result << 'EXTRA'
+        expect(@cm.matches?(hash: doc_hash, filepath: 'test_Main', section: :defines, context: :test)).to eq(['A', 'BLESS_YOU'])
+      end
+
+      it 'matches separately for each matcher hash' do
+        expect(@cm.matches?(hash: { :Foo => ['ONE'] }, filepath: 'test_Foo', section: :defines, context: :test)).to eq(['ONE'])
+        expect(@cm.matches?(hash: { :Foo => ['TWO'] }, filepath: 'test_Foo', section: :defines, context: :test)).to eq(['TWO'])
+      end
+    end
+
   end # #matches?
 
 end
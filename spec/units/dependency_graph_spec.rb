@@ -0,0 +1,78 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/dependency_graph'
+require 'ceedling/file_wrapper'
+
+describe DependencyGraph do
+  before(:each) do
+    @graph = described_class.new( {:file_wrapper => FileWrapper.new} )
+
+    @tmpdir = Dir.mktmpdir
+    @source = File.join( @tmpdir, 'src dir', 'foo.c' )
+    @header = File.join( @tmpdir, 'foo.h' )
+    @object = File.join( @tmpdir, 'foo.o' )
+    @deps   = File.join( @tmpdir, 'foo.d' )
+    @fingerprint = File.join( @tmpdir, 'foo.fingerprint' )
+
+    FileUtils.mkdir_p( File.dirname( @source ) )
+    File.write( @source, 'int foo;' )
+    File.write( @header, '#define FOO' )
+    File.write( @object, 'object' )
+    File.write( @deps, "# Generated\n#{@object}: #{@source.gsub(' ', '\\ ')} \\\n #{@header}\n#{@header}:\n" )
+
+    # Object built after its source and header
+    past = Time.now - 60
+    File.utime( past, past, @source )
+    File.utime( past, past, @header )
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  it "tracks only targets with a dependencies file" do
+    @graph.load( { @object => @deps, 'bar.o' => File.join( @tmpdir, 'bar.d' ) } )
+
+    expect( @graph.tracked?( @object ) ).to be true
+    expect( @graph.tracked?( 'bar.o' ) ).to be false
+  end
+
+  it "finds a target stale by timestamp when a header it includes is newer" do
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :timestamp ) ).to be false
+
+    FileUtils.touch( @header, mtime: Time.now + 60 )
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :timestamp ) ).to be true
+  end
+
+  it "finds a target stale when a file it depends on (with spaces in its path) is missing" do
+    File.delete( @source )
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :timestamp ) ).to be true
+  end
+
+  it "finds a target stale by checksum only when contents change" do
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :checksum, fingerprint: @fingerprint ) ).to be true
+
+    @graph.record( @object, @deps, @fingerprint )
+
+    FileUtils.touch( @header, mtime: Time.now + 60 )
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :checksum, fingerprint: @fingerprint ) ).to be false
+
+    File.write( @header, '#define BAR' )
+    @graph.load( { @object => @deps } )
+    expect( @graph.stale?( @object, detection: :checksum, fingerprint: @fingerprint ) ).to be true
+  end
+
+end
@@ -0,0 +1,115 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/explainer'
+require 'ceedling/file_wrapper'
+
+describe Explainer do
+  before(:each) do
+    @loginator = double( 'Loginator' ).as_null_object
+    @explainer = described_class.new( {:loginator => @loginator, :file_wrapper => FileWrapper.new} )
+    @tmpdir = Dir.mktmpdir
+    @logs = File.join( @tmpdir, 'logs' )
+
+    @source = File.join( @tmpdir, 'a.c' )
+    @object = File.join( @tmpdir, 'a.o' )
+    File.write( @source, '' )
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  def build(command: 'cc a.c')
+    @explainer.stage( 'Building Objects', node: :objects, context: :test ) do
+      @explainer.item( test: 'test_a', file: @object ) do
+        @explainer.artifact( :objects, test: 'test_a', outputs: [@object], inputs: [@source] ) do
+          @explainer.command( command )
+          File.write( @object, '' )
+        end
+      end
+    end
+  end
+
+  def report()
+    @explainer.report()
+    return File.read( File.join( @logs, EXPLAIN_REPORT_FILENAME ) )
+  end
+
+  it "only yields when not enabled" do
+    expect( @explainer.artifact( :objects, test: 'test_a', outputs: [@object] ) { 42 } ).to eq 42
+
+    @explainer.report()
+    expect( File.exist?( @logs ) ).to be false
+  end
+
+  it "explains a missing output" do
+    @explainer.enable( @logs )
+    build()
+    expect( report() ).to match( /Missing\s+objects\s+#{Regexp.escape( @object )}/ )
+  end
+
+  it "explains a changed input" do
+    File.write( @object, '' )
+    File.utime( Time.now - 60, Time.now - 60, @object )
+
+    @explainer.enable( @logs )
+    build()
+    expect( report() ).to include( "Changed input    objects  #{@object} (#{@source})" )
+  end
+
+  it "explains a changed command from that recorded by a previous build" do
+    @explainer.enable( @logs )
+    build( command: 'cc a.c' )
+    @explainer.report()
+
+    explainer = described_class.new( {:loginator => @loginator, :file_wrapper => FileWrapper.new} )
+    explainer.enable( @logs )
+    @explainer = explainer
+
+    File.utime( Time.now - 60, Time.now - 60, @source )
+    build( command: 'cc -O2 a.c' )
+    expect( report() ).to include( "Changed command  objects  #{@object}" )
+  end
+
+  it "explains an up-to-date output as forced and reports the critical path" do
+    File.utime( Time.now - 60, Time.now - 60, @source )
+    File.write( @object, '' )
+
+    @explainer.enable( @logs )
+    build()
+
+    contents = report()
+    expect( contents ).to include( "Forced           objects  #{@object}" )
+    expect( contents ).to match( /Critical path: [\d.]+s of [\d.]+s/ )
+    expect( contents ).to match( /objects\s+[\d.]+s  test_a \| #{Regexp.escape( @object )}/ )
+  end
+
+  it "reports the slowest item of each node, whichever its test, as the critical path" do
+    @explainer.enable( @logs )
+
+    # test_a has the longest chain of its own, but test_b's link is the slowest
+    allow(@explainer).to receive(:clock).and_return( 0.0, 0.0, 5.0, 5.0, 5.0, 5.0, 6.0, 6.0, 7.0, 7.0, 10.0, 10.0 )
+    @explainer.stage( 'Building Objects', node: :objects, context: :test ) do
+      @explainer.item( test: 'test_a', file: 'a.o' ) {}
+      @explainer.item( test: 'test_b', file: 'b.o' ) {}
+    end
+    @explainer.stage( 'Linking', node: :link, context: :test ) do
+      @explainer.item( test: 'test_a', file: 'a.out' ) {}
+      @explainer.item( test: 'test_b', file: 'b.out' ) {}
+    end
+
+    contents = report()
+    expect( contents ).to include( 'Critical path: 8.000s of 9.000s' )
+    expect( contents ).to match( /objects\s+5\.000s  test_a \| a\.o/ )
+    expect( contents ).to match( /link\s+3\.000s  test_b \| b\.out/ )
+  end
+
+end
@@ -131,6 +131,12 @@ SIMPLE_PASS_OUTPUT   = "test_lib.c:3:test_empty:PASS\n---------\n1 Tests 0 Failu
 SIMPLE_FAIL_OUTPUT   = "test_lib.c:8:test_bad:FAIL: Expected 1 Was 2\n---------\n1 Tests 1 Failures 0 Ignored\nFAIL\n"
 SIMPLE_IGNORE_OUTPUT = "test_lib.c:12:test_skip:IGNORE\n---------\n1 Tests 0 Failures 1 Ignored\nOK\n"
 
+# A gdb session transcript running each group's output in turn, delimited by run markers
+def gdb_session(*outputs)
+  preamble = "Reading symbols from build/test/out/test_lib/test_lib.out...\n"
+  return preamble + outputs.each_with_index.map { |output, index| "\n#{BACKTRACE_GDB_SESSION_MARKER} #{index}\n#{output}" }.join
+end
+
 
 describe GeneratorTestResultsBacktrace do
 
@@ -197,9 +203,8 @@ describe GeneratorTestResultsBacktrace do
 
     it 'handles a PASS test case and does not write a log' do
       allow(@tool_executor).to receive(:exec).and_return(
-        { output: GDB_NO_SIGNAL_OUTPUT, time: 0.1, exit_code: 1, stderr: '', status: @ok_status },
-        { output: "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n",
-          time: 0.1, exit_code: 0, stderr: '', status: @ok_status }
+        { output: gdb_session( GDB_NO_SIGNAL_OUTPUT, "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n" ),
+          time: 0.2, exit_code: 0, stderr: '', status: @ok_status }
       )
 
       expect(@file_wrapper).to receive(:write).once.with(%r{test_crashes_elsewhere}, anything, anything)
@@ -217,9 +222,8 @@ describe GeneratorTestResultsBacktrace do
 
     it 'handles an IGNORE test case and does not write a log' do
       allow(@tool_executor).to receive(:exec).and_return(
-        { output: GDB_NO_SIGNAL_OUTPUT, time: 0.1, exit_code: 1, stderr: '', status: @ok_status },
-        { output: "test_lib.c:9:test_asserting:IGNORE\n---------\n1 Tests 0 Failures 1 Ignored\nOK\n",
-          time: 0.1, exit_code: 0, stderr: '', status: @ok_status }
+        { output: gdb_session( GDB_NO_SIGNAL_OUTPUT, "test_lib.c:9:test_asserting:IGNORE\n---------\n1 Tests 0 Failures 1 Ignored\nOK\n" ),
+          time: 0.2, exit_code: 0, stderr: '', status: @ok_status }
       )
 
       expect(@file_wrapper).to receive(:write).once.with(%r{test_crashes_elsewhere}, anything, anything)
@@ -237,9 +241,8 @@ describe GeneratorTestResultsBacktrace do
 
     it 'handles a FAIL test case and does not write a log' do
       allow(@tool_executor).to receive(:exec).and_return(
-        { output: GDB_NO_SIGNAL_OUTPUT, time: 0.1, exit_code: 1, stderr: '', status: @ok_status },
-        { output: "test_lib.c:9:test_asserting:FAIL: Expected 1 Was 2\n---------\n1 Tests 1 Failures 0 Ignored\nFAIL\n",
-          time: 0.1, exit_code: 1, stderr: '', status: @ok_status }
+        { output: gdb_session( GDB_NO_SIGNAL_OUTPUT, "test_lib.c:9:test_asserting:FAIL: Expected 1 Was 2\n---------\n1 Tests 1 Failures 0 Ignored\nFAIL\n" ),
+          time: 0.2, exit_code: 0, stderr: '', status: @ok_status }
       )
 
       expect(@file_wrapper).to receive(:write).once.with(%r{test_crashes_elsewhere}, anything, anything)
@@ -261,7 +264,7 @@ describe GeneratorTestResultsBacktrace do
       bad_status = double('status', signaled?: false, success?: false, exitstatus: 1, termsig: nil)
 
       allow(@tool_executor).to receive(:exec).and_return({
-        output: "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n",
+        output: gdb_session( "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n" ),
         time: 0.1, exit_code: 0, stderr: '', status: bad_status
       })
 
@@ -282,7 +285,7 @@ describe GeneratorTestResultsBacktrace do
       # differently-configured environment even though the main run genuinely crashed.
       # An all-clean diagnostic must not be allowed to overrule that.
       allow(@tool_executor).to receive(:exec).and_return({
-        output: "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n",
+        output: gdb_session( "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n" ),
         time: 0.1, exit_code: 0, stderr: '', status: @ok_status
       })
 
@@ -301,7 +304,7 @@ describe GeneratorTestResultsBacktrace do
       filename_sigsegv   = 'TestUsartModel.c'
 
       allow(@tool_executor).to receive(:exec)
-        .and_return({ output: GDB_SIGSEGV_OUTPUT, time: 0.5, exit_code: 139, stderr: '', status: @ok_status })
+        .and_return({ output: gdb_session( GDB_SIGSEGV_OUTPUT ), time: 0.5, exit_code: 139, stderr: '', status: @ok_status })
 
       expected_output_lines = []
       allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
@@ -331,7 +334,7 @@ describe GeneratorTestResultsBacktrace do
       filename_param = 'test_module_d.c'
 
       allow(@tool_executor).to receive(:exec)
-        .and_return({ output: GDB_SIGSEGV_PARAM_OUTPUT, time: 0.5, exit_code: 139, stderr: '', status: @ok_status })
+        .and_return({ output: gdb_session( GDB_SIGSEGV_PARAM_OUTPUT ), time: 0.5, exit_code: 139, stderr: '', status: @ok_status })
 
       expected_output_lines = []
       allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
@@ -357,7 +360,7 @@ describe GeneratorTestResultsBacktrace do
       test_cases_assert = [{ test: 'test_asserting', symbol: 'test_asserting', line_number: 8 }]
 
       allow(@tool_executor).to receive(:exec)
-        .and_return({ output: GDB_SIGABRT_ASSERT_OUTPUT, time: 0.3, exit_code: 134, stderr: '', status: @ok_status })
+        .and_return({ output: gdb_session( GDB_SIGABRT_ASSERT_OUTPUT ), time: 0.3, exit_code: 134, stderr: '', status: @ok_status })
 
       expected_output_lines = []
       allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
@@ -378,7 +381,7 @@ describe GeneratorTestResultsBacktrace do
 
     it 'handles a crash with no identifiable signal — fallback message, log path without "log: " prefix' do
       allow(@tool_executor).to receive(:exec)
-        .and_return({ output: GDB_NO_SIGNAL_OUTPUT, time: 0.1, exit_code: 1, stderr: '', status: @ok_status })
+        .and_return({ output: gdb_session( GDB_NO_SIGNAL_OUTPUT ), time: 0.1, exit_code: 1, stderr: '', status: @ok_status })
 
       expected_output_lines = []
       allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
@@ -393,6 +396,53 @@ describe GeneratorTestResultsBacktrace do
       expect(crash_line).not_to include('(log: ')
       expect(crash_line).to include('(/build/logs/test/test_lib/test_asserting.gdb.log)')
     end
+
+    it 'runs every test case in a single gdb session' do
+      session_script = nil
+      allow(@file_wrapper).to receive(:write).with('build/test/out/test_lib/test_lib.backtrace.gdb', anything) do |_, contents|
+        session_script = contents
+      end
+
+      expect(@tool_executor).to receive(:build_command_line)
+        .with({}, [], 'build/test/out/test_lib/test_lib.backtrace.gdb', executable)
+        .once.and_return({ options: {} })
+      expect(@tool_executor).to receive(:exec).once.and_return(
+        { output: gdb_session( GDB_NO_SIGNAL_OUTPUT, "test_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n" ),
+          time: 0.2, exit_code: 0, stderr: '', status: @ok_status }
+      )
+
+      result = @backtrace.do_gdb( filename, executable, shell_result, [companion_case] + test_cases, context: :test )
+
+      expect(session_script.scan(/^run .+$/)).to eq( ['run -n "test_crashes_elsewhere"', 'run -n "test_asserting"'] )
+      expect(session_script.scan(/^source "build\/test\/backtrace.gdb"$/).size).to eq(2)
+      expect(result[:time]).to eq(0.2)
+    end
+
+    it 'resumes in a new gdb session with the next test case when a session ends early' do
+      session_scripts = []
+      allow(@file_wrapper).to receive(:write).with('build/test/out/test_lib/test_lib.backtrace.gdb', anything) do |_, contents|
+        session_scripts << contents
+      end
+
+      # First session aborts after the crashing first run (no marker for the second run)
+      allow(@tool_executor).to receive(:exec).and_return(
+        { output: gdb_session( GDB_NO_SIGNAL_OUTPUT ), time: 0.1, exit_code: 1, stderr: '', status: @ok_status },
+        { output: "\n#{BACKTRACE_GDB_SESSION_MARKER} 1\ntest_lib.c:9:test_asserting:PASS\n---------\n1 Tests 0 Failures 0 Ignored\nOK\n",
+          time: 0.1, exit_code: 0, stderr: '', status: @ok_status }
+      )
+
+      expected_output_lines = []
+      allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
+        expected_output_lines = kwargs[:output]
+        'regenerated'
+      end
+
+      @backtrace.do_gdb( filename, executable, shell_result, [companion_case] + test_cases, context: :test )
+
+      expect(session_scripts.size).to eq(2)
+      expect(session_scripts.last.scan(/^run .+$/)).to eq( ['run -n "test_asserting"'] )
+      expect(expected_output_lines).to include('test_lib.c:9:test_asserting:PASS')
+    end
   end
 
   # ── #do_simple ─────────────────────────────────────────────────────────────
@@ -405,6 +455,8 @@ describe GeneratorTestResultsBacktrace do
 
     before(:each) do
       allow(@configurator).to receive(:tools_test_fixture_simple_backtrace).and_return({})
+      # A single worker keeps diagnostic runs (and the stubbed results below) in order
+      allow(@configurator).to receive(:project_test_threads).and_return(1)
     end
 
     # Each of the three cases below is paired with a companion group that genuinely
@@ -551,6 +603,131 @@ describe GeneratorTestResultsBacktrace do
     end
   end
 
+  # ── #do_simple with bisection ──────────────────────────────────────────────
+
+  describe '#do_simple with bisect' do
+    let(:filename)    { 'test_lib.c' }
+    let(:executable)  { 'build/test/out/test_lib/test_lib.out' }
+    let(:shell_result){ { exit_code: 1, output: '', time: 0.0 } }
+    let(:test_cases)  { (1..8).map { |n| { test: "test_#{n}", line_number: n * 10 } } }
+
+    before(:each) do
+      allow(@configurator).to receive(:tools_test_fixture_simple_backtrace).and_return({})
+      allow(@configurator).to receive(:project_test_threads).and_return(1)
+
+      # The filter argument selects the test cases run by each stubbed sub-process
+      allow(@tool_executor).to receive(:build_command_line) do |_tool, _extra, _executable, filter|
+        { options: {}, filter: filter }
+      end
+    end
+
+    # Simulates the executable: test_6 crashes; every other case passes
+    def simulate(command)
+      expect(command[:filter]).to start_with('-n ')
+      names = command[:filter][/"(.+)"/, 1].split(',')
+      selected = test_cases.select { |test_case| names.include?( test_case[:test] ) }
+
+      if selected.any? { |test_case| test_case[:test] == 'test_6' }
+        return { output: SIMPLE_ASSERT_CRASH_OUTPUT, time: 0.1, exit_code: 134, stderr: '', status: @ok_status }
+      end
+
+      lines = selected.map { |test_case| "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:PASS" }
+      output = lines.join("\n") + "\n---------\n#{selected.size} Tests 0 Failures 0 Ignored\nOK\n"
+      return { output: output, time: 0.05, exit_code: 0, stderr: '', status: @ok_status }
+    end
+
+    it 'isolates the crashing test case in logarithmic runs and keeps every other real result' do
+      runs = 0
+      allow(@tool_executor).to receive(:exec) { |command| runs += 1; simulate( command ) }
+
+      expected_output_lines = []
+      allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
+        expected_output_lines = kwargs[:output]
+        'regenerated'
+      end
+
+      result = @backtrace.do_simple( filename, executable, shell_result, test_cases, context: :test, bisect: true )
+
+      # 8 -> 4 + 4 -> 2 + 2 -> 1 + 1
+      expect(runs).to eq(7)
+      expect(result[:exit_code]).to eq(1)
+      expect(expected_output_lines.size).to eq(8)
+      expect(expected_output_lines[5]).to include('test_6:FAIL: Test case crashed')
+      expect(expected_output_lines - [expected_output_lines[5]]).to all( end_with(':PASS') )
+    end
+
+    it 'runs parameterized test cases apart from the groups it bisects' do
+      param_cases = [
+        { test: 'test_p(1)', line_number: 90 },
+        { test: 'test_p(2)', line_number: 90 }
+      ]
+
+      filters = []
+      allow(@tool_executor).to receive(:exec) do |command|
+        filters << command[:filter]
+        next simulate( command ) if command[:filter].start_with?('-n ')
+
+        lines = param_cases.map { |test_case| "#{filename}:#{test_case[:line_number]}:#{test_case[:test]}:PASS" }
+        { output: lines.join("\n") + "\n---------\n2 Tests 0 Failures 0 Ignored\nOK\n", time: 0.05, exit_code: 0, stderr: '', status: @ok_status }
+      end
+      allow(@generator_test_results).to receive(:regenerate_test_executable_stdout).and_return('regenerated')
+
+      @backtrace.do_simple( filename, executable, shell_result, test_cases + param_cases, context: :test, bisect: true )
+
+      expect(filters).to include('-f "test_p("')
+      expect(filters.count { |filter| filter.include?('test_p') }).to eq(1)
+      expect(filters.size).to eq(8)
+    end
+  end
+
+  # ── concurrency of diagnostic runs ─────────────────────────────────────────
+
+  describe '#do_simple from several tests at once' do
+    let(:executable)  { 'build/test/out/test_lib/test_lib.out' }
+    let(:shell_result){ { exit_code: 1, output: '', time: 0.0 } }
+
+    it 'never runs more diagnostic sub-processes at once than :test_threads' do
+      allow(@configurator).to receive(:tools_test_fixture_simple_backtrace).and_return({})
+      allow(@configurator).to receive(:project_test_threads).and_return(2)
+      allow(@tool_executor).to receive(:build_command_line).and_return({ options: {} })
+      allow(@generator_test_results).to receive(:regenerate_test_executable_stdout).and_return('regenerated')
+
+      lock = Mutex.new
+      running = 0
+      peak = 0
+      allow(@tool_executor).to receive(:exec) do
+        lock.synchronize { running += 1; peak = [peak, running].max }
+        sleep( 0.02 )
+        lock.synchronize { running -= 1 }
+        { output: SIMPLE_ASSERT_CRASH_OUTPUT, time: 0.02, exit_code: 134, stderr: '', status: @ok_status }
+      end
+
+      tests = (1..2).map do |n|
+        Thread.new do
+          test_cases = (1..4).map { |m| { test: "test_#{n}_#{m}", line_number: m * 10 } }
+          @backtrace.do_simple( "test_#{n}.c", executable, shell_result, test_cases, context: :test )
+        end
+      end
+      tests.each( &:join )
+
+      expect(peak).to be <= 2
+    end
+  end
+
+  # ── private #unity_filter_arg ──────────────────────────────────────────────
+
+  describe '#unity_filter_arg (private)' do
+    it 'selects non-parameterized test cases by exact name' do
+      groups = [[{ test: 'test_foo' }], [{ test: 'test_bar' }]]
+      expect(@backtrace.send(:unity_filter_arg, groups)).to eq('-n "test_foo,test_bar"')
+    end
+
+    it 'selects a parameterized test case by its name and opening parenthesis' do
+      groups = [[{ test: 'test_foo(1, 2)' }, { test: 'test_foo(3, 4)' }]]
+      expect(@backtrace.send(:unity_filter_arg, groups)).to eq('-f "test_foo("')
+    end
+  end
+
   # ── private #format_signal_label ───────────────────────────────────────────
 
   describe '#format_signal_label (private)' do
@@ -678,7 +855,7 @@ describe GeneratorTestResultsBacktrace do
 
     it 'uses assertion label and metadata line number when no crash location frame is found' do
       allow(@tool_executor).to receive(:exec)
-        .and_return({ output: GDB_WINDOWS_ASSERT_BRIEF_OUTPUT, time: 0.1, exit_code: 3, stderr: '', status: @ok_status })
+        .and_return({ output: gdb_session( GDB_WINDOWS_ASSERT_BRIEF_OUTPUT ), time: 0.1, exit_code: 3, stderr: '', status: @ok_status })
 
       expected_output_lines = []
       allow(@generator_test_results).to receive(:regenerate_test_executable_stdout) do |**kwargs|
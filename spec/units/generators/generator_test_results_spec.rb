@@ -11,6 +11,8 @@ require 'fileutils'
 require 'ceedling/generators/generator_test_results_sanity_checker'
 require 'ceedling/generators/generator_test_results'
 require 'ceedling/yaml_wrapper'
+require 'ceedling/file_wrapper'
+require 'ceedling/test_results_store'
 require 'ceedling/constants'
 require 'ceedling/config/configurator'
 
@@ -140,7 +142,16 @@ describe GeneratorTestResults do
       :ruby_expandinator    => nil
     })
 
+    # Compare written results against YAML fixture files
+    allow(@configurator).to receive(:test_build_results_format).and_return(:yaml)
+    allow(@configurator).to receive(:test_build_results_stdout_limit).and_return(10000)
+
     @yaml_wrapper = YamlWrapper.new
+    @test_results_store = TestResultsStore.new({
+      :configurator => @configurator,
+      :file_wrapper => FileWrapper.new,
+      :yaml_wrapper => @yaml_wrapper
+    })
     @sanity_checker = GeneratorTestResultsSanityChecker.new({
       :configurator => @configurator,
       :loginator    => @loginator
@@ -151,7 +162,7 @@ describe GeneratorTestResults do
       :generator_test_results_sanity_checker => @sanity_checker,
       :loginator                             => @loginator,
       :reportinator                          => @reportinator,
-      :yaml_wrapper                          => @yaml_wrapper
+      :test_results_store                    => @test_results_store
     })
 
     @tmpdir = Dir.mktmpdir
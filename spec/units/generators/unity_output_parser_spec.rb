@@ -0,0 +1,113 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'ceedling/generators/unity_output_parser'
+
+UNITY_OUTPUT =
+  "Verbose output one\n" +
+  "test_example.c:257:test_one:PASS\n" +
+  "test_example.c:263:test_two:IGNORE\n" +
+  "test_example.c:269:test_three:FAIL: Expected 1 Was 2\n" +
+  "\n" +
+  "-----------------------\n" +
+  "3 Tests 1 Failures 1 Ignored \n" +
+  "FAIL\n".freeze
+
+describe UnityOutputParser do
+  def new_parser(stdout_limit: nil, &block)
+    return described_class.new(
+      executable: 'build/test/out/test_example.out',
+      test_file: 'test/test_example.c',
+      stdout_limit: stdout_limit,
+      &block
+    )
+  end
+
+  it "parses output fed all at once" do
+    parser = new_parser()
+    results = (parser << UNITY_OUTPUT).finish()
+
+    expect( parser.statistics? ).to be true
+    expect( results[:counts] ).to eq( {:total => 3, :passed => 1, :failed => 1, :ignored => 1} )
+    expect( results[:successes].map {|test| test[:test]} ).to eq( ['test_one'] )
+    expect( results[:ignores].map {|test| test[:test]} ).to eq( ['test_two'] )
+    expect( results[:failures][0] ).to include( :test => 'test_three', :line => 269, :message => 'Expected 1 Was 2' )
+    expect( results[:stdout] ).to eq( ['Verbose output one'] )
+  end
+
+  it "parses identically when output arrives in arbitrary chunks" do
+    expected = (new_parser() << UNITY_OUTPUT).finish()
+
+    [1, 2, 7, 33].each do |size|
+      parser = new_parser()
+      UNITY_OUTPUT.chars.each_slice( size ) {|chunk| parser << chunk.join() }
+      expect( parser.finish() ).to eq( expected )
+    end
+  end
+
+  it "does not corrupt multibyte characters split across chunks" do
+    parser = new_parser()
+    bytes = "Température: 25°C\n".b
+    parser << bytes.byteslice( 0, 5 )
+    parser << bytes.byteslice( 5..-1 )
+    parser << UNITY_OUTPUT
+
+    expect( parser.finish()[:stdout] ).to eq( ['Température: 25°C', 'Verbose output one'] )
+  end
+
+  it "reports each test case result as it is parsed" do
+    reported = []
+    parser = new_parser() {|status, test_case| reported << [status, test_case[:test]] }
+
+    parser << UNITY_OUTPUT.lines[0..2].join()
+    expect( reported ).to eq( [[:pass, 'test_one'], [:ignore, 'test_two']] )
+
+    parser << UNITY_OUTPUT.lines[3..-1].join()
+    expect( reported.last ).to eq( [:fail, 'test_three'] )
+  end
+
+  it "strips ANSI color from results and statistics" do
+    output = "test_example.c:257:test_one:\e[0;32mPASS\e[0m\n\n-----------------------\n1 Tests 0 Failures 0 Ignored \n\e[0;32mOK\e[0m\n"
+    parser = new_parser()
+    results = (parser << output).finish()
+
+    expect( parser.statistics? ).to be true
+    expect( results[:successes].map {|test| test[:test]} ).to eq( ['test_one'] )
+  end
+
+  it "keeps only a limited number of stdout lines" do
+    parser = new_parser( stdout_limit: 2 )
+    5.times {|i| parser << "printf #{i}\n" }
+    parser << UNITY_OUTPUT
+
+    expect( parser.finish()[:stdout] ).to eq( ['printf 0', 'printf 1', '[4 more lines of test output omitted]'] )
+  end
+
+  it "treats dashed lines not followed by statistics as stdout" do
+    parser = new_parser()
+    results = (parser << "-----\nnot statistics\n" + UNITY_OUTPUT).finish()
+
+    expect( results[:stdout] ).to eq( ['-----', 'not statistics', 'Verbose output one'] )
+    expect( results[:counts][:total] ).to eq( 3 )
+  end
+
+  it "reports missing statistics" do
+    parser = new_parser()
+    parser << "test_example.c:257:test_one:PASS\n"
+    parser.finish()
+
+    expect( parser.statistics? ).to be false
+  end
+
+  it "raises a malformed result line from finish" do
+    parser = new_parser()
+    expect{ parser << "test_example.c:269:test_tVerbous output two\nwo:PASS\n" }.not_to raise_error
+    expect{ parser.finish() }.to raise_error( CeedlingException, /Could not parse/ )
+  end
+
+end
@@ -0,0 +1,126 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/includes/include_pathinator'
+require 'ceedling/file_wrapper'
+require 'ceedling/yaml_wrapper'
+
+# Only minimal search paths are covered here
+describe IncludePathinator do
+  before(:each) do
+    @pathinator = described_class.new(
+      {
+        :configurator           => double( 'Configurator' ),
+        :test_context_extractor => double( 'TestContextExtractor' ),
+        :loginator              => double( 'Loginator' ),
+        :file_wrapper           => FileWrapper.new,
+        :yaml_wrapper           => YamlWrapper.new
+      }
+    )
+    @tmpdir = Dir.mktmpdir
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  def write_dependencies(name, contents)
+    filepath = File.join( @tmpdir, name )
+    File.write( filepath, contents )
+    return filepath
+  end
+
+  context "#minimize_search_paths" do
+    it "keeps, in order, only search paths containing a header that was included" do
+      dependencies = [
+        write_dependencies( 'a.d', "build/a.o: src/a.c inc/b.h \\\n  vendor/lib/sub/c.h /usr/include/stdio.h\n" ),
+        write_dependencies( 'b.d', "build/b.o: test/test_a.c build/mocks/mock_b.h\n" )
+      ]
+
+      search_paths = ['build/mocks', 'unused', 'vendor/lib', 'inc', 'vendor/lib/sub', 'other']
+
+      minimal = @pathinator.minimize_search_paths( search_paths: search_paths, dependencies: dependencies )
+      expect( minimal ).to eq ['build/mocks', 'vendor/lib', 'inc', 'vendor/lib/sub']
+    end
+
+    it "finds nothing if a dependencies file is missing" do
+      dependencies = [ File.join( @tmpdir, 'missing.d' ) ]
+      expect( @pathinator.minimize_search_paths( search_paths: ['inc'], dependencies: dependencies ) ).to be_nil
+    end
+  end
+
+  context "#load_minimal_search_paths" do
+    before(:each) do
+      @filepath = File.join( @tmpdir, 'cache', 'search_paths.yml' )
+      @source = write_dependencies( 'a.c', "#include \"b.h\"\n" )
+      @header = write_dependencies( 'b.h', "" )
+      @dependencies = [ write_dependencies( 'a.d', "build/a.o: #{@source} #{@header}\n" ) ]
+    end
+
+    it "loads minimal search paths stored for the same search paths" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to eq ['b']
+    end
+
+    it "ignores minimal search paths stored for different search paths" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b', 'c'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to be_nil
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a'], defines: ['A'], flags: ['-O1'], filepath: File.join( @tmpdir, 'none.yml' ) ) ).to be_nil
+    end
+
+    it "ignores minimal search paths stored for different defines or flags" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A', 'USE_CONFIG'], flags: ['-O1'], filepath: @filepath ) ).to be_nil
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1', '-include', 'config.h'], filepath: @filepath ) ).to be_nil
+    end
+
+    it "ignores minimal search paths once a source or header they were found for changes" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      File.write( @source, "#include \"b.h\"\n#include \"config.h\"\n" )
+      @pathinator.forget_file_digests()
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to be_nil
+    end
+
+    it "ignores minimal search paths once a header they were found for is gone" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      File.delete( @header )
+      @pathinator.forget_file_digests()
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to be_nil
+    end
+
+    it "reads each source and header once until told to forget their contents" do
+      allow( Digest::SHA256 ).to receive(:file).and_call_original
+
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to eq ['b']
+      expect( Digest::SHA256 ).to have_received(:file).twice
+
+      File.write( @header, "#include \"config.h\"\n" )
+      @pathinator.forget_file_digests()
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to be_nil
+      expect( Digest::SHA256 ).to have_received(:file).exactly(4).times
+    end
+
+    it "keeps minimal search paths when a file is regenerated with the same contents" do
+      @pathinator.store_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], minimal: ['b'], dependencies: @dependencies, filepath: @filepath )
+
+      File.write( @header, "" )
+      File.utime( Time.now + 60, Time.now + 60, @header )
+      @pathinator.forget_file_digests()
+      expect( @pathinator.load_minimal_search_paths( search_paths: ['a', 'b'], defines: ['A'], flags: ['-O1'], filepath: @filepath ) ).to eq ['b']
+    end
+  end
+
+end
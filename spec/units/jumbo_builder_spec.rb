@@ -0,0 +1,70 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/jumbo_builder'
+require 'ceedling/file_wrapper'
+
+describe JumboBuilder do
+  before(:each) do
+    @configurator = double( 'Configurator', :extension_source => '.c' )
+    @builder = described_class.new( {:configurator => @configurator, :file_wrapper => FileWrapper.new} )
+    @tmpdir = Dir.mktmpdir
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  context "#eligible" do
+    it "keeps only C sources not excluded or generated" do
+      sources = [
+        'src/a.c',
+        'src/isr.c',
+        'src/legacy/old.c',
+        'src/startup.s',
+        'build/test/partials/ceedling_partial_b.c',
+        'build/release/ceedling_jumbo_1.c'
+      ]
+
+      expect( @builder.eligible( sources, exclude: ['isr.c', 'src/legacy/**'] ) ).to eq ['src/a.c']
+    end
+  end
+
+  context "#generate" do
+    it "combines nothing if the unit size is less than 2" do
+      expect( @builder.generate( sources: ['a.c', 'b.c'], size: 1, build_path: @tmpdir ) ).to eq({})
+      expect( Dir.empty?( @tmpdir ) ).to be true
+    end
+
+    it "groups sorted sources into units and leaves a lone remainder on its own" do
+      units = @builder.generate( sources: ['src/c.c', 'src/a.c', 'src/b.c'], size: 2, build_path: @tmpdir )
+
+      unit = File.join( @tmpdir, 'ceedling_jumbo_1.c' )
+      expect( units ).to eq( { unit => ['src/a.c', 'src/b.c'] } )
+
+      contents = File.read( unit )
+      expect( contents ).to include( "#include \"#{File.expand_path( 'src/a.c' )}\"\n" )
+      expect( contents ).to include( "#include \"#{File.expand_path( 'src/b.c' )}\"\n" )
+      expect( contents ).not_to include( 'c.c' )
+    end
+
+    it "leaves a unit with unchanged contents untouched" do
+      unit = File.join( @tmpdir, 'ceedling_jumbo_1.c' )
+
+      @builder.generate( sources: ['a.c', 'b.c'], size: 2, build_path: @tmpdir )
+      past = Time.now - 60
+      File.utime( past, past, unit )
+
+      @builder.generate( sources: ['b.c', 'a.c'], size: 2, build_path: @tmpdir )
+      expect( File.mtime( unit ).to_i ).to eq past.to_i
+    end
+  end
+
+end
@@ -0,0 +1,100 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'json'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/constants'
+require 'ceedling/loginator'
+require 'ceedling/file_wrapper'
+require 'ceedling/system_wrapper'
+
+describe Loginator do
+  before(:each) do
+    @verbosinator = double('verbosinator')
+    allow(@verbosinator).to receive(:should_output?).and_return(false)
+
+    @system_wrapper = SystemWrapper.new
+    allow(@system_wrapper).to receive(:time_now).and_return('May  1 22:20:40 2024')
+
+    @loginator = described_class.new(
+      {
+        :verbosinator   => @verbosinator,
+        :file_wrapper   => FileWrapper.new,
+        :system_wrapper => @system_wrapper
+      }
+    )
+
+    @tmpdir = Dir.mktmpdir
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  context "#set_logfile" do
+    it "writes all messages to a text log file once logging wraps up" do
+      filepath = File.join( @tmpdir, 'ceedling.log' )
+      @loginator.set_logfile( filepath )
+
+      @loginator.log( "Compiling Foo.c...\nDone", Verbosity::DEBUG )
+      @loginator.log( "Bad things", Verbosity::ERRORS )
+      @loginator.event( :tool, {:tool => 'test_compiler'} )
+      @loginator.wrapup()
+
+      expect( File.read( filepath ) ).to eq(
+        "<IO:$stdout> May  1 22:20:40 2024 | Compiling Foo.c...\n" +
+        "                                    Done\n" +
+        "<IO:$stderr> May  1 22:20:40 2024 | ERROR: Bad things\n"
+      )
+    end
+
+    it "writes JSON lines with stage, test, and event fields to a structured log file" do
+      filepath = File.join( @tmpdir, 'ceedling.jsonl' )
+      @loginator.set_logfile( filepath, :json )
+
+      @loginator.stage = 'Building Objects'
+      @loginator.with_fields( test: 'TestFoo' ) do
+        @loginator.log( "Compiling Foo.c...", Verbosity::DEBUG )
+        @loginator.event( :tool, {:tool => 'test_compiler', :duration => 0.25, :exit_code => 0} )
+      end
+      @loginator.wrapup()
+
+      entries = File.readlines( filepath ).map {|line| JSON.parse( line, symbolize_names: true ) }
+
+      expect( entries.size ).to eq( 2 )
+      expect( entries[0] ).to include( :verbosity => 'debug', :stage => 'Building Objects', :test => 'TestFoo', :message => 'Compiling Foo.c...' )
+      expect( entries[1] ).to include( :event => 'tool', :tool => 'test_compiler', :duration => 0.25, :exit_code => 0, :test => 'TestFoo' )
+    end
+  end
+
+  context "#capture" do
+    it "collects serializable log items for a later replay" do
+      filepath = File.join( @tmpdir, 'ceedling.log' )
+      @loginator.set_logfile( filepath )
+
+      result, items = @loginator.capture do
+        @loginator.log( "Generating mock for Foo.h...", Verbosity::DEBUG )
+        @loginator.log( "Bad things", Verbosity::ERRORS )
+        :generated
+      end
+
+      expect( result ).to eq :generated
+      items = Marshal.load( Marshal.dump( items ) )
+
+      @loginator.replay( items )
+      @loginator.wrapup()
+
+      expect( File.read( filepath ) ).to eq(
+        "<IO:$stdout> May  1 22:20:40 2024 | Generating mock for Foo.h...\n" +
+        "<IO:$stderr> May  1 22:20:40 2024 | ERROR: Bad things\n"
+      )
+    end
+  end
+
+end
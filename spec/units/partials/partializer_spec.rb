@@ -13,6 +13,8 @@ require 'ceedling/partials/partials'
 require 'ceedling/reportinator'
 require 'ceedling/c_extractor/c_extractor_types'
 require 'ostruct'
+require 'tmpdir'
+require 'fileutils'
 
 describe Partializer do
   before(:each) do
@@ -1418,6 +1420,55 @@ describe Partializer do
 
       @partializer.extract_module_contents(@name, config, false)
     end
+
+    context "with preprocessed files on disk" do
+      before(:each) do
+        @tmpdir = Dir.mktmpdir
+        @preprocessed = { 'TestA' => File.join(@tmpdir, 'a_module1.i'), 'TestB' => File.join(@tmpdir, 'b_module1.i') }
+        @preprocessed.each_value { |filepath| File.write(filepath, "void func1(void) {}\n") }
+
+        allow(@file_path_utils).to receive(:form_preprocessed_file_raw_directives_only_filepath) do |filepath, name|
+          File.join(@tmpdir, name, File.basename(filepath))
+        end
+      end
+
+      after(:each) do
+        FileUtils.rm_rf(@tmpdir)
+      end
+
+      def make_config(directives_only_filepath)
+        return Partials::Config.new(
+          module: 'module1',
+          header: Partials::ConfigFileInfo.new(filepath: nil, directives_only_filepath: nil),
+          source: Partials::ConfigFileInfo.new(filepath: '/src/module1.c', directives_only_filepath: directives_only_filepath)
+        )
+      end
+
+      it "extracts identical preprocessed contents once for all tests" do
+        source_funcs = [double('func1', name: 'func1')]
+
+        expect(@c_extractor).to receive(:from_file).once
+          .and_return(CExtractorTypes::CModule.new(function_definitions: source_funcs))
+        expect(@partializer_helper).to receive(:associate_function_line_numbers).once
+
+        a = @partializer.extract_module_contents('TestA', make_config(@preprocessed['TestA']), false)
+        b = @partializer.extract_module_contents('TestB', make_config(@preprocessed['TestB']), false)
+
+        expect(a.function_definitions).to eq(source_funcs)
+        expect(b.function_definitions).to eq(source_funcs)
+        # Each test receives its own CModule to modify (e.g. `sanitize()`)
+        expect(b.function_definitions).not_to be(a.function_definitions)
+      end
+
+      it "extracts differing preprocessed contents separately" do
+        File.write(@preprocessed['TestB'], "void func2(void) {}\n")
+
+        expect(@c_extractor).to receive(:from_file).twice.and_return(CExtractorTypes::CModule.new)
+
+        @partializer.extract_module_contents('TestA', make_config(@preprocessed['TestA']), false)
+        @partializer.extract_module_contents('TestB', make_config(@preprocessed['TestB']), false)
+      end
+    end
   end
 
   ###
@@ -21,6 +21,7 @@ $: << File.expand_path('../../../../plugins/cppcheck/lib', __FILE__)
 
 require 'cppcheck_constants'
 require 'cppcheck_reports'
+require 'cppcheck_results'
 require 'cppcheck'
 require 'ceedling/ruby_expandinator'
 
@@ -240,6 +241,67 @@ describe Cppcheck do
     end
   end
 
+  # -------------------------------------------------------------------------
+  describe '#build_fragment_opts' do
+    it 'replaces the shared build directory with per-file XML output' do
+      cppcheck = build_cppcheck(config: { xml_report_version: 2 })
+      opts = cppcheck.send(:build_fragment_opts)
+      expect(opts).to include('--enable=all', '--xml', '--xml-version=2')
+      expect(opts).not_to include(a_string_starting_with('--cppcheck-build-dir'))
+    end
+
+    it 'suppresses unusedFunction, which cannot be judged one file at a time' do
+      cppcheck = build_cppcheck(config: {})
+      expect(cppcheck.send(:build_fragment_opts)).to include('--suppress=unusedFunction', '--xml-version=3')
+    end
+  end
+
+  # -------------------------------------------------------------------------
+  describe '#generate_reports' do
+    let(:xml_report)  { double('xml_report', from_results?: true) }
+    let(:text_report) { double('text_report', from_results?: false) }
+
+    before(:each) do
+      stub_const('COLLECTION_PATHS_INCLUDE', ['inc'])
+      stub_const('COLLECTION_PATHS_SOURCE', ['src'])
+    end
+
+    def build_reporting_cppcheck(config)
+      cppcheck = build_cppcheck(config: config)
+      cppcheck.instance_variable_set(:@reports, { xml: xml_report, text: text_report })
+      cppcheck
+    end
+
+    it 'runs Cppcheck over the whole project for every report by default' do
+      cppcheck = build_reporting_cppcheck({})
+      expect(cppcheck).not_to receive(:analyze_files)
+      expect(xml_report).to receive(:generate).with(kind_of(Array), ['inc'], ['src'])
+      expect(text_report).to receive(:generate).with(kind_of(Array), ['inc'], ['src'])
+
+      cppcheck.generate_reports()
+    end
+
+    it 'writes XML from merged per-file results and leaves other formats to Cppcheck when incremental' do
+      cppcheck = build_reporting_cppcheck({ incremental: true })
+      results = CppcheckResults.new([])
+      allow(cppcheck).to receive(:analysis_filepaths).and_return(['src/a.c'])
+      expect(cppcheck).to receive(:analyze_files).with(['src/a.c']).and_return(results)
+      expect(xml_report).to receive(:generate_from_results).with(results)
+      expect(text_report).to receive(:generate).with(kind_of(Array), ['inc'], ['src'])
+
+      cppcheck.generate_reports()
+    end
+  end
+
+  # -------------------------------------------------------------------------
+  describe '#analysis_filepaths' do
+    it 'omits excluded files and directories from project sources' do
+      stub_const('COLLECTION_ALL_SOURCE', ['src/a.c', 'src/b.c', 'lib/x/c.c', 'lib/y.c'])
+      cppcheck = build_cppcheck(config: { excludes: ['b.c', 'lib/x/'] })
+      expect(cppcheck.send(:analysis_filepaths)).to eq(['src/a.c', 'lib/y.c'])
+    end
+  end
+
   # -------------------------------------------------------------------------
   describe '#build_file_opts' do
     it 'adds --enable flag when enable_checks is configured' do
@@ -444,6 +506,15 @@ describe CppcheckXmlReport do
     report = described_class.new(system_objects, {})
     expect(report.artifact_filepath).to eq('artifacts/cppcheck/CppcheckReport.xml')
   end
+
+  it 'writes merged results when analyzing incrementally' do
+    allow(file_wrapper).to receive(:write)
+    report = described_class.new(system_objects, {})
+
+    expect(report.from_results?).to be true
+    expect(file_wrapper).to receive(:write).with('artifacts/cppcheck/CppcheckReport.xml', a_string_including('<results'))
+    report.generate_from_results(CppcheckResults.new([]))
+  end
 end
 
 # ===========================================================================
@@ -523,6 +594,11 @@ describe CppcheckTextReport do
     expect(report.report_type).to eq(:text)
   end
 
+  it 'is left to Cppcheck rather than written from merged results' do
+    stub_const('CPPCHECK_ARTIFACTS_FILE_TEXT', 'CppcheckReport.txt')
+    expect(described_class.new(system_objects, {}).from_results?).to be false
+  end
+
   it 'derives artifact_filepath from config when text_artifact_filename is set' do
     stub_const('CPPCHECK_ARTIFACTS_FILE_TEXT', 'CppcheckReport.txt')
     report = described_class.new(system_objects, { text_artifact_filename: 'Custom.txt' })
@@ -549,9 +625,51 @@ describe CppcheckSarifReport do
     expect(report.report_type).to eq(:sarif)
   end
 
+  it 'is left to Cppcheck rather than written from merged results' do
+    stub_const('CPPCHECK_ARTIFACTS_FILE_SARIF', 'CppcheckReport.sarif')
+    expect(described_class.new(system_objects, {}).from_results?).to be false
+  end
+
   it 'derives artifact_filepath from config when sarif_artifact_filename is set' do
     stub_const('CPPCHECK_ARTIFACTS_FILE_SARIF', 'CppcheckReport.sarif')
     report = described_class.new(system_objects, { sarif_artifact_filename: 'Custom.sarif' })
     expect(report.artifact_filepath).to eq('artifacts/cppcheck/Custom.sarif')
   end
 end
+
+# ===========================================================================
+describe CppcheckResults do
+  def fragment(*errors)
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" +
+    "<results version=\"2\">\n" +
+    "    <cppcheck version=\"2.13.0\"/>\n" +
+    "    <errors>\n" + errors.join("\n") + "\n    </errors>\n" +
+    "</results>\n"
+  end
+
+  let(:uninitvar) do
+    '<error id="uninitvar" severity="error" msg="Uninitialized variable: x" verbose="Uninitialized variable: x" cwe="457">' +
+    '<location file="src/a.c" line="4" column="10" info="Uninitialized variable: x"/>' +
+    '<location file="src/a.c" line="3" column="6" info="x is declared here"/>' +
+    '</error>'
+  end
+
+  let(:header_style) do
+    '<error id="unusedStructMember" severity="style" msg="struct member is never used." verbose="v" cwe="563">' +
+    '<location file="inc/a.h" line="2" column="9"/>' +
+    '</error>'
+  end
+
+  it 'merges findings of all fragments once each' do
+    results = described_class.new([fragment(uninitvar, header_style), fragment(header_style)])
+    expect(results.errors.map {|error| error.attributes['id']}).to eq(['uninitvar', 'unusedStructMember'])
+    expect(results.cppcheck_version).to eq('2.13.0')
+  end
+
+  it 'writes merged findings as Cppcheck XML' do
+    xml = described_class.new([fragment(uninitvar), fragment(header_style)]).to_xml
+    document = REXML::Document.new(xml)
+    expect(document.root.attributes['version']).to eq('2')
+    expect(document.get_elements('results/errors/error').size).to eq(2)
+  end
+end
@@ -0,0 +1,117 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/constants'
+
+# Define Ceedling runtime path and tool constants needed by gcov_constants.rb and
+# reportgenerator_reportinator.rb.  The `unless defined?` guard keeps them from being
+# re-assigned if another spec already loaded them.
+PROJECT_BUILD_ROOT           = 'build'     unless defined?(PROJECT_BUILD_ROOT)
+PROJECT_BUILD_ARTIFACTS_ROOT = 'artifacts' unless defined?(PROJECT_BUILD_ARTIFACTS_ROOT)
+TOOLS_GCOV_COMPILER          = {}          unless defined?(TOOLS_GCOV_COMPILER)
+TOOLS_TEST_ASSEMBLER         = {}          unless defined?(TOOLS_TEST_ASSEMBLER)
+TOOLS_GCOV_LINKER            = {}          unless defined?(TOOLS_GCOV_LINKER)
+TOOLS_GCOV_FIXTURE           = {}          unless defined?(TOOLS_GCOV_FIXTURE)
+TOOLS_GCOV_REPORT            = {}          unless defined?(TOOLS_GCOV_REPORT)
+
+$: << File.expand_path('../../../../plugins/gcov/lib', __FILE__)
+
+require 'gcov_constants'
+require 'reportgenerator_reportinator'
+
+# Build a ReportGeneratorReportinator without running its constructor (tool validation)
+# so that unit tests can exercise its gcov processing in isolation.
+def build_reportgenerator_reportinator(tool_executor:, loginator: nil)
+  instance = ReportGeneratorReportinator.allocate
+  instance.instance_variable_set(:@tool_executor,  tool_executor)
+  instance.instance_variable_set(:@loginator,      loginator)
+  instance.instance_variable_set(:@gcov_cwd_mutex, Mutex.new)
+  instance
+end
+
+GCOV_STDOUT_TWO_SOURCES = <<~OUTPUT
+  File 'src/a/utils.c'
+  Lines executed:100.00% of 2
+          -:    0:Source:src/a/utils.c
+          -:    0:Graph:build/gcov/out/test_utils/utils.gcno
+          1:    1:int a(void) { return 1; }
+          -:    0:Source:src/b/utils.c
+          -:    0:Graph:build/gcov/out/test_utils/utils.gcno
+      #####:    1:int b(void) { return 2; }
+OUTPUT
+
+describe ReportGeneratorReportinator do
+  before(:each) do
+    @tool_executor = double('ToolExecutor')
+    @reportinator = build_reportgenerator_reportinator(tool_executor: @tool_executor)
+
+    @tmpdir = Dir.mktmpdir
+    @gcno_filepath = File.join(@tmpdir, 'utils.gcno')
+  end
+
+  after(:each) do
+    FileUtils.rm_rf(@tmpdir)
+  end
+
+  describe '#split_gcov_stdout (private)' do
+    it 'splits output into the content of each source file' do
+      sections = @reportinator.send(:split_gcov_stdout, GCOV_STDOUT_TWO_SOURCES)
+
+      expect(sections.map(&:first)).to eq(['src/a/utils.c', 'src/b/utils.c'])
+      expect(sections[0][1].lines.size).to eq(3)
+      expect(sections[0][1]).to start_with('        -:    0:Source:src/a/utils.c')
+      expect(sections[1][1]).to include('int b(void)')
+      expect(sections[1][1]).not_to include('int a(void)')
+    end
+
+    it 'ignores output before the first source file' do
+      expect(@reportinator.send(:split_gcov_stdout, "File 'src/a/utils.c'\nNo executable lines\n")).to eq([])
+    end
+  end
+
+  describe '#gcov_filename (private)' do
+    it 'names the .gcov files of same-named sources in different directories apart' do
+      a = @reportinator.send(:gcov_filename, 'src/a/utils.c')
+      b = @reportinator.send(:gcov_filename, 'src/b/utils.c')
+
+      expect(a).to start_with('utils.c##')
+      expect(a).to end_with('.gcov')
+      expect(a).not_to eq(b)
+      expect(@reportinator.send(:gcov_filename, 'src/a/utils.c')).to eq(a)
+    end
+  end
+
+  describe '#run_gcov (private)' do
+    it 'writes one .gcov file per source file beside the .gcno file' do
+      allow(@tool_executor).to receive(:build_command_line)
+        .and_return({ line: "gcov --stdout -b \"#{@gcno_filepath}\"", options: {} })
+      allow(@tool_executor).to receive(:exec)
+        .and_return({ stdout: GCOV_STDOUT_TWO_SOURCES, output: GCOV_STDOUT_TWO_SOURCES, exit_code: 0 })
+
+      @reportinator.send(:run_gcov, @gcno_filepath, @tmpdir)
+
+      a = File.join(@tmpdir, @reportinator.send(:gcov_filename, 'src/a/utils.c'))
+      b = File.join(@tmpdir, @reportinator.send(:gcov_filename, 'src/b/utils.c'))
+
+      expect(Dir.glob(File.join(@tmpdir, '*.gcov')).size).to eq(2)
+      expect(File.read(a)).to include('int a(void)')
+      expect(File.read(b)).to include('int b(void)')
+    end
+
+    it 'lets a gcov tool configured without --stdout write into the working directory' do
+      allow(@tool_executor).to receive(:build_command_line)
+        .and_return({ line: "gcov -b \"#{@gcno_filepath}\"", options: {} })
+      expect(@reportinator).to receive(:run_gcov_in_cwd).and_return({ exit_code: 0 })
+      expect(@tool_executor).not_to receive(:exec)
+
+      @reportinator.send(:run_gcov, @gcno_filepath, @tmpdir)
+    end
+  end
+end
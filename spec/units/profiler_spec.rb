@@ -0,0 +1,72 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'json'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/profiler'
+require 'ceedling/file_wrapper'
+
+describe Profiler do
+  before(:each) do
+    @loginator = double( 'Loginator' ).as_null_object
+    @profiler = described_class.new( {:loginator => @loginator, :file_wrapper => FileWrapper.new} )
+    @tmpdir = Dir.mktmpdir
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  it "only yields when not enabled" do
+    expect( @profiler.span( 'stage', category: :stage ) { 42 } ).to eq 42
+
+    @profiler.report()
+    expect( Dir.empty?( @tmpdir ) ).to be true
+  end
+
+  it "writes a summary and a trace of nested stage, item, and tool spans" do
+    @profiler.enable( @tmpdir )
+
+    result = @profiler.span( 'Compiling', category: :stage, args: {:context => :test} ) do
+      @profiler.span( 'item', category: :item, args: {:test => 'test_a', :file => 'a.c'} ) do
+        @profiler.span( 'Test Compiler', category: :tool ) { :compiled }
+      end
+    end
+
+    expect( result ).to eq :compiled
+
+    @profiler.report()
+
+    summary = File.read( File.join( @tmpdir, PROFILE_SUMMARY_FILENAME ) )
+    expect( summary ).to include( 'Compiling' )
+    expect( summary ).to include( 'Compiling | test_a | a.c [Test Compiler]' )
+    expect( summary ).to include( 'Test Compiler' )
+
+    events = JSON.parse( File.read( File.join( @tmpdir, PROFILE_TRACE_FILENAME ) ) )['traceEvents']
+    expect( events.map {|event| event['cat']} ).to contain_exactly( 'stage', 'item', 'tool' )
+    expect( events.all? {|event| event['ph'] == 'X'} ).to be true
+
+    item = events.find {|event| event['cat'] == 'item'}
+    expect( item['args'] ).to include( 'test' => 'test_a', 'file' => 'a.c', 'stage' => 'Compiling' )
+  end
+
+  it "records a span when its block raises" do
+    @profiler.enable( @tmpdir )
+
+    expect {
+      @profiler.span( 'Test Linker', category: :tool ) { raise 'failed' }
+    }.to raise_error( RuntimeError )
+
+    @profiler.report()
+
+    events = JSON.parse( File.read( File.join( @tmpdir, PROFILE_TRACE_FILENAME ) ) )['traceEvents']
+    expect( events.map {|event| event['name']} ).to eq ['Test Linker']
+  end
+
+end
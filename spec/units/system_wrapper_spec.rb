@@ -7,6 +7,7 @@
 
 require 'spec_helper'
 require 'ceedling/system_wrapper'
+require 'tmpdir'
 
 describe SystemWrapper do
   before(:each) do
@@ -68,5 +69,15 @@ describe SystemWrapper do
       expect(result[:stderr]).to eq('err')
       expect(result[:output]).to eq('outerr')
     end
+
+    it 'runs a command in its own working directory and environment without changing the process' do
+      dir = File.realpath( Dir.tmpdir )
+      result = @sys_wrapper.shell_capture3(
+        command: ruby_command('print Dir.pwd, "|", ENV["CEEDLING_SPEC_VAR"]'), boom: false, chdir: dir, env: {'CEEDLING_SPEC_VAR' => 'set'}
+      )
+      expect(result[:stdout]).to eq("#{dir}|set")
+      expect(Dir.pwd).not_to eq(dir)
+      expect(ENV['CEEDLING_SPEC_VAR']).to be_nil
+    end
   end
 end
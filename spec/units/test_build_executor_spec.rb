@@ -8,6 +8,8 @@
 require 'spec_helper'
 require 'ceedling/test_invoker/test_build_executor'
 require 'ceedling/test_invoker/test_invoker_types'
+require 'ceedling/partials/partials'
+require 'ceedling/explainer'
 
 PROJECT_BUILD_VENDOR_UNITY_PATH = 'build/vendor/unity' unless defined?(PROJECT_BUILD_VENDOR_UNITY_PATH)
 UNITY_C_FILE = 'unity.c' unless defined?(UNITY_C_FILE)
@@ -26,6 +28,8 @@ describe TestBuildExecutor do
     @file_path_utils                              = double( "FilePathUtils" )
     @file_finder                                     = double( "FileFinder" )
     @file_wrapper                                       = double( "FileWrapper" )
+    @include_pathinator                                    = double( "IncludePathinator" )
+    @explainer                                                = Explainer.new( {:loginator => nil, :file_wrapper => nil} )
 
     @tools_test_compiler  = { name: 'fake compiler' }
     @tools_test_assembler = { name: 'fake assembler' }
@@ -53,7 +57,9 @@ describe TestBuildExecutor do
         :plugin_manager          => @plugin_manager,
         :file_path_utils         => @file_path_utils,
         :file_finder             => @file_finder,
-        :file_wrapper            => @file_wrapper
+        :file_wrapper            => @file_wrapper,
+        :include_pathinator      => @include_pathinator,
+        :explainer               => @explainer
       }
     )
 
@@ -110,5 +116,162 @@ describe TestBuildExecutor do
         :context => :test, :test => :a_test, :source => 'src/foo.asm', :object => 'build/foo.o', :state => @state
       )
     end
+
+    context "with minimal search paths" do
+      before(:each) do
+        allow(@file_wrapper).to receive(:extname).with( 'src/foo.c' ).and_return( '.c' )
+        allow(@loginator).to receive(:log)
+
+        testable = @state.testables[:a_test]
+        testable.search_paths = ['mocks', 'src', 'lib']
+        testable.minimal_search_paths = ['src']
+      end
+
+      it "compiles with the minimal search paths" do
+        expect(@generator).to receive(:generate_object_file_c) do |**args|
+          expect( args[:search_paths] ).to eq ['src']
+        end
+
+        @executor.send(
+          :compile_test_component,
+          :context => :test, :test => :a_test, :source => 'src/foo.c', :object => 'build/foo.o', :state => @state
+        )
+      end
+
+      it "discards minimal search paths and retries a failed compilation with all search paths" do
+        allow(@file_path_utils).to receive(:form_test_search_paths_cache_filepath).and_return( 'build/cache/search_paths.yml' )
+        expect(@file_wrapper).to receive(:rm_f).with( 'build/cache/search_paths.yml' )
+
+        expect(@generator).to receive(:generate_object_file_c).ordered.and_raise( ShellException.new( name: 'fake compiler', message: 'failed' ) )
+        expect(@generator).to receive(:generate_object_file_c).ordered do |**args|
+          expect( args[:search_paths] ).to eq ['mocks', 'src', 'lib']
+        end
+
+        @executor.send(
+          :compile_test_component,
+          :context => :test, :test => :a_test, :source => 'src/foo.c', :object => 'build/foo.o', :state => @state
+        )
+      end
+
+      it "fails a compilation that also fails with all search paths" do
+        allow(@file_path_utils).to receive(:form_test_search_paths_cache_filepath).and_return( 'build/cache/search_paths.yml' )
+        allow(@file_wrapper).to receive(:rm_f)
+
+        expect(@generator).to receive(:generate_object_file_c).twice.and_raise( ShellException.new( name: 'fake compiler', message: 'failed' ) )
+
+        expect {
+          @executor.send(
+            :compile_test_component,
+            :context => :test, :test => :a_test, :source => 'src/foo.c', :object => 'build/foo.o', :state => @state
+          )
+        }.to raise_error( ShellException )
+      end
+    end
+  end
+
+  context "#stage_preprocess_partial_sources" do
+    before(:each) do
+      allow(@configurator).to receive(:project_build_vendor_ceedling_path).and_return( 'build/vendor/ceedling' )
+
+      # Run batch jobs in order on the calling thread
+      @batches = 0
+      allow(@batchinator).to receive(:exec) do |workload:, things:, &block|
+        @batches += 1
+        things.each { |thing| block.call( thing ) }
+      end
+
+      @config = Partials::ConfigFileInfo.new( filepath: 'src/foo.c' )
+      @testable = TestInvokerTypes::Testable.new(
+        :name               => 'test_foo',
+        :search_paths       => ['src'],
+        :preprocess_flags   => [],
+        :preprocess_defines => []
+      )
+      @state.partials_sources = [{ :config => @config, :testable => @testable }]
+    end
+
+    it "runs all preprocessing passes for a file in one job" do
+      allow(@configurator).to receive(:test_build_preprocess_directives_only_available).and_return( true )
+
+      expect(@preprocessinator).to receive(:generate_directives_only_output).ordered.and_return( 'build/raw/foo.c' )
+      expect(@preprocessinator).to receive(:preprocess_partial_source_file_preserve_macros).ordered do |**args|
+        expect( args[:directives_only_filepath] ).to eq( 'build/raw/foo.c' )
+        expect( args[:fallback] ).to be false
+        ['build/preprocessed/foo.c', ['foo.h']]
+      end
+      expect(@preprocessinator).to receive(:preprocess_partial_source_expand_macros).ordered.and_return( 'build/full/foo.c' )
+
+      @executor.stage_preprocess_partial_sources( @state )
+
+      expect( @batches ).to eq 1
+      expect( @config.directives_only_filepath ).to eq( 'build/preprocessed/foo.c' )
+      expect( @config.includes ).to eq( ['foo.h'] )
+      expect( @config.full_expansion_filepath ).to eq( 'build/full/foo.c' )
+    end
+
+    it "falls back without directives-only preprocessing" do
+      allow(@configurator).to receive(:test_build_preprocess_directives_only_available).and_return( false )
+
+      expect(@preprocessinator).to_not receive(:generate_directives_only_output)
+      expect(@preprocessinator).to receive(:preprocess_partial_source_file_preserve_macros) do |**args|
+        expect( args[:directives_only_filepath] ).to be_nil
+        expect( args[:fallback] ).to be true
+        ['build/preprocessed/foo.c', []]
+      end
+      allow(@preprocessinator).to receive(:preprocess_partial_source_expand_macros).and_return( nil )
+
+      @executor.stage_preprocess_partial_sources( @state )
+    end
+  end
+
+  context "#stage_generate_partials" do
+    before(:each) do
+      @batches = []
+      allow(@batchinator).to receive(:exec) do |workload:, things:, &block|
+        @batches << things
+        things.map { |thing| block.call( thing ) }
+      end
+
+      foo = Partials::Config.new( module: 'foo', source: Partials::ConfigFileInfo.new( filepath: 'src/foo.c' ) )
+      bar = Partials::Config.new( module: 'bar', source: Partials::ConfigFileInfo.new( filepath: 'src/bar.c' ) )
+
+      @testables = {
+        :test_a => TestInvokerTypes::Testable.new( :name => 'test_a' ),
+        :test_b => TestInvokerTypes::Testable.new( :name => 'test_b' ),
+        :test_c => TestInvokerTypes::Testable.new( :name => 'test_c' )
+      }
+      @testables[:test_a].partials.configs = { 'foo' => foo, 'bar' => bar }
+      @testables[:test_b].partials.configs = { 'bar' => bar }
+      @testables[:test_c].partials.configs = { 'foo' => foo }
+      @state = TestInvokerTypes::PipelineState.new( :testables => @testables )
+
+      # Each test's Partial of a module generates its tests and mocks modules
+      allow(@executor).to receive(:generate_partial) do |config:, testable:|
+        { tests: "#{testable.name}_#{config.module}", mocks: "mock_#{testable.name}_#{config.module}" }
+      end
+    end
+
+    it "hands each test's Partials to worker threads one at a time" do
+      allow(@configurator).to receive(:project_ruby_workers).and_return( :threads )
+
+      @executor.stage_generate_partials( @state )
+
+      expect( @batches.first.size ).to eq 4
+      expect( @testables[:test_a].partials.tests ).to eq ['test_a_foo', 'test_a_bar']
+      expect( @testables[:test_b].partials.mocks ).to eq ['mock_test_b_bar']
+    end
+
+    it "hands all tests Partialing the same module to one worker process" do
+      allow(@configurator).to receive(:project_ruby_workers).and_return( :processes )
+
+      @executor.stage_generate_partials( @state )
+
+      expect( @batches.first.map { |batch| batch[:name] } ).to eq ['foo', 'bar']
+      expect( @batches.first.map { |batch| batch[:partials].map { |partial| partial[:testable].name } } ).to eq [['test_a', 'test_c'], ['test_a', 'test_b']]
+      expect( @testables[:test_a].partials.tests ).to eq ['test_a_foo', 'test_a_bar']
+      expect( @testables[:test_a].partials.mocks ).to eq ['mock_test_a_foo', 'mock_test_a_bar']
+      expect( @testables[:test_b].partials.tests ).to eq ['test_b_bar']
+      expect( @testables[:test_c].partials.mocks ).to eq ['mock_test_c_foo']
+    end
   end
 end
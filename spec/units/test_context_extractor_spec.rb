@@ -434,4 +434,41 @@ describe TestContextExtractor do
 
   end
 
+  context "#restore_context" do
+    it "should restore everything collected for a file as of its snapshot" do
+      filepath = "path/tests/test_file.c"
+
+      preprocessed = <<~CONTENTS
+      #include "unity.h"
+      #include "mock_foo.h"
+      TEST_SOURCE_FILE("bar.c")
+      void test_this_function(void) {}
+      CONTENTS
+
+      raw = <<~CONTENTS
+      #include "unity.h"
+      #include "other.h"
+      CONTENTS
+
+      contexts = [
+        TestContextExtractor::Context::INCLUDES,
+        TestContextExtractor::Context::BUILD_DIRECTIVE_SOURCE_FILES,
+        TestContextExtractor::Context::TEST_RUNNER_DETAILS
+      ]
+
+      @extractor.collect_context( filepath, StringIO.new( preprocessed ), *contexts )
+      snapshot = @extractor.snapshot_context( filepath )
+
+      # A later build re-collects simpler context from the raw test file
+      @extractor.collect_context( filepath, StringIO.new( raw ), TestContextExtractor::Context::INCLUDES )
+      expect( @extractor.lookup_all_header_includes_list( filepath ).map(&:filename) ).to eq ['unity.h', 'other.h']
+
+      @extractor.restore_context( filepath, snapshot )
+
+      expect( @extractor.lookup_all_header_includes_list( filepath ).map(&:filename) ).to eq ['unity.h', 'mock_foo.h']
+      expect( @extractor.lookup_build_directive_sources_list( filepath ) ).to eq ['bar.c']
+      expect( @extractor.lookup_test_cases( filepath ).map { |test_case| test_case[:test] } ).to eq ['test_this_function']
+    end
+  end
+
 end
@@ -0,0 +1,101 @@
+# =========================================================================
+#   Ceedling - Test-Centered Build System for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2010-26 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require 'spec_helper'
+require 'tmpdir'
+require 'fileutils'
+require 'ceedling/file_wrapper'
+require 'ceedling/yaml_wrapper'
+require 'ceedling/test_results_store'
+
+describe TestResultsStore do
+  before(:each) do
+    @configurator = double('configurator')
+    allow(@configurator).to receive(:test_build_results_format).and_return(:json)
+
+    @yaml_wrapper = YamlWrapper.new
+
+    @store = described_class.new(
+      {
+        :configurator => @configurator,
+        :file_wrapper => FileWrapper.new,
+        :yaml_wrapper => @yaml_wrapper
+      }
+    )
+
+    @results = {
+      :source    => {:file => 'test/test_foo.c', :dirname => 'test', :basename => 'test_foo.c'},
+      :successes => [{:test => 'test_a', :line => 12, :message => '', :unity_test_time => 0.0}],
+      :failures  => [{:test => 'test_b', :line => 20, :message => "Expected 1\nWas 2", :unity_test_time => 0.0}],
+      :ignores   => [],
+      :counts    => {:total => 2, :passed => 1, :failed => 1, :ignored => 0},
+      :stdout    => ['printf output: 100%'],
+      :time      => 0.25
+    }
+
+    @tmpdir = Dir.mktmpdir
+    @filepath = File.join( @tmpdir, 'test_foo.fail' )
+  end
+
+  after(:each) do
+    FileUtils.rm_rf( @tmpdir )
+  end
+
+  context "#write" do
+    it "should write compact JSON by default" do
+      @store.write( @filepath, @results )
+      expect( File.read( @filepath ) ).to start_with( '{"source":' )
+    end
+
+    it "should write YAML when configured to" do
+      allow(@configurator).to receive(:test_build_results_format).and_return(:yaml)
+      @store.write( @filepath, @results )
+      expect( @yaml_wrapper.load( @filepath ) ).to eq( @results )
+    end
+
+    it "should write JSON for binary test executable output" do
+      @results[:stdout] = ["raw \xFF\xFE bytes".b, "bad \xC3(".dup.force_encoding( Encoding::UTF_8 )]
+      @store.write( @filepath, @results )
+
+      loaded = described_class.new( {:configurator => @configurator, :file_wrapper => FileWrapper.new, :yaml_wrapper => @yaml_wrapper} ).load( @filepath )
+      expect( loaded[:stdout] ).to eq ["raw \uFFFD\uFFFD bytes", "bad \uFFFD("]
+      expect( @store.fetch( @filepath ) ).to equal( @results )
+    end
+  end
+
+  context "#fetch" do
+    it "should return results written this build by filepath with or without extension" do
+      @store.write( @filepath, @results )
+      expect( @store.fetch( @filepath ) ).to equal( @results )
+      expect( @store.fetch( File.join( @tmpdir, 'test_foo' ) ) ).to equal( @results )
+      expect( @store.fetch( File.join( @tmpdir, 'test_foo.pass' ) ) ).to equal( @results )
+    end
+
+    it "should return nil for results not yet written or loaded" do
+      expect( @store.fetch( @filepath ) ).to be_nil
+    end
+  end
+
+  context "#load" do
+    it "should round trip JSON results with symbol keys" do
+      @store.write( @filepath, @results )
+      expect( described_class.new( {:configurator => @configurator, :file_wrapper => FileWrapper.new, :yaml_wrapper => @yaml_wrapper} ).load( @filepath ) ).to eq( @results )
+    end
+
+    it "should load YAML results regardless of configured format" do
+      @yaml_wrapper.dump( @filepath, @results )
+      expect( @store.load( @filepath ) ).to eq( @results )
+      expect( @store.fetch( @filepath ) ).to eq( @results )
+    end
+
+    it "should complain about a corrupted JSON results file" do
+      File.write( @filepath, '{"source":' )
+      expect{ @store.load( @filepath ) }.to raise_error( CeedlingException, /Malformed JSON/ )
+    end
+  end
+
+end
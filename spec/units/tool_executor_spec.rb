@@ -8,11 +8,15 @@
 require 'spec_helper'
 require 'ceedling/tool_executor'
 require 'ceedling/ruby_expandinator'
+require 'ceedling/profiler'
+require 'ceedling/explainer'
 require 'ceedling/exceptions'
+require 'tmpdir'
+require 'fileutils'
 
 # Scoped narrowly to the inline Ruby string expansion (--ruby-replacement) behavior
-# introduced by RubyExpandinator. Broader ToolExecutor coverage is a pre-existing gap
-# outside this feature's scope.
+# introduced by RubyExpandinator, compiled command templates, and response files. Broader ToolExecutor
+# coverage is a pre-existing gap outside these features' scope.
 describe ToolExecutor do
   before(:each) do
     @configurator = double('configurator').as_null_object
@@ -22,6 +26,8 @@ describe ToolExecutor do
     @verbosinator = double('verbosinator').as_null_object
     @system_wrapper = double('system_wrapper').as_null_object
     @ruby_expandinator = RubyExpandinator.new
+    @profiler = Profiler.new( {:loginator => @loginator, :file_wrapper => nil} )
+    @explainer = Explainer.new( {:loginator => @loginator, :file_wrapper => nil} )
 
     @tool_executor = described_class.new(
       {
@@ -30,7 +36,9 @@ describe ToolExecutor do
         :loginator => @loginator,
         :verbosinator => @verbosinator,
         :system_wrapper => @system_wrapper,
-        :ruby_expandinator => @ruby_expandinator
+        :ruby_expandinator => @ruby_expandinator,
+        :profiler => @profiler,
+        :explainer => @explainer
       }
     )
   end
@@ -80,4 +88,98 @@ describe ToolExecutor do
       expect(command[:line]).to include('--flag=2')
     end
   end
+
+  describe '#build_command_line — compiled command templates' do
+    before(:each) do
+      @tool_config = {
+        :name => 'my_tool',
+        :executable => 'compiler',
+        :arguments => [ '-c "${1}"', '-I${2}', '-DSTATIC', 42 ]
+      }
+    end
+
+    it 'expands input replacements anew for each call' do
+      first  = @tool_executor.build_command_line( @tool_config, [], 'a.c', ['inc', 'lib'] )
+      second = @tool_executor.build_command_line( @tool_config, ['-g'], 'b.c', [] )
+
+      expect(first[:line]).to eq('compiler -c "a.c" -Iinc -Ilib -DSTATIC')
+      expect(second[:line]).to eq('compiler -g -c "b.c" -DSTATIC')
+    end
+
+    it 'leaves the tool configuration unmodified' do
+      @tool_config[:arguments] << '  -DPADDED  '
+
+      @tool_executor.build_command_line( @tool_config, [], 'a.c', [] )
+
+      expect(@tool_config[:arguments]).to eq([ '-c "${1}"', '-I${2}', '-DSTATIC', 42, '  -DPADDED  ' ])
+    end
+
+    it 'reflects arguments added to the tool configuration after first use' do
+      @tool_executor.build_command_line( @tool_config, [], 'a.c', [] )
+
+      @tool_config[:arguments] << '-fPIC'
+
+      command = @tool_executor.build_command_line( @tool_config, [], 'a.c', [] )
+      expect(command[:line]).to eq('compiler -c "a.c" -DSTATIC -fPIC')
+    end
+
+    it 'raises CeedlingException for each call missing a referenced argument' do
+      2.times do
+        expect {
+          @tool_executor.build_command_line( @tool_config, [], 'a.c' )
+        }.to raise_error(CeedlingException, /provided only 1 arguments but references a replacement operator \$\{2\}/)
+      end
+    end
+
+    it 'evaluates inline Ruby string expansion for each call' do
+      @ruby_expandinator.enable!
+      @tool_config[:arguments] = [ '-DCOUNT=#{$tool_executor_spec_count += 1}' ]
+      $tool_executor_spec_count = 0
+
+      @tool_executor.build_command_line( @tool_config, [] )
+      command = @tool_executor.build_command_line( @tool_config, [] )
+
+      expect(command[:line]).to eq('compiler -DCOUNT=2')
+    end
+  end
+
+  describe '#build_command_line — response files' do
+    before(:each) do
+      @tmpdir = Dir.mktmpdir
+      @tool_config = {
+        :name => 'my_tool',
+        :executable => 'compiler',
+        :arguments => [ '-c "${1}"', '-I"${2}"', '-D${3}', '-o "${4}"' ]
+      }
+      @response_file = { :path => @tmpdir, :replacements => [2, 3] }
+    end
+
+    after(:each) do
+      FileUtils.rm_rf( @tmpdir )
+    end
+
+    it 'moves the named replacements into a response file at the position of the first' do
+      command = @tool_executor.build_command_line( @tool_config, [], 'a.c', ['inc', 'C:\\lib'], ['A=1'], 'a.o', response_file: @response_file )
+
+      filepath = Dir.glob( File.join( @tmpdir, '*.rsp' ) ).first
+      expect(command[:line]).to eq("compiler -c \"a.c\" \"@#{filepath}\" -o \"a.o\"")
+      # Backslashes the shell would keep are escaped
+      expect(File.read( filepath )).to eq("-I\"inc\" -I\"C:\\\\lib\"\n-DA=1\n")
+    end
+
+    it 'writes a single response file for commands expanding the same arguments' do
+      first  = @tool_executor.build_command_line( @tool_config, [], 'a.c', ['inc'], ['A=1'], 'a.o', response_file: @response_file )
+      second = @tool_executor.build_command_line( @tool_config, [], 'b.c', ['inc'], ['A=1'], 'b.o', response_file: @response_file )
+
+      expect(Dir.children( @tmpdir ).size).to eq(1)
+      expect(first[:line][/@[^"]+/]).to eq(second[:line][/@[^"]+/])
+    end
+
+    it 'writes no response file if the named replacements expand to nothing' do
+      command = @tool_executor.build_command_line( @tool_config, [], 'a.c', [], [], 'a.o', response_file: @response_file )
+
+      expect(command[:line]).to eq('compiler -c "a.c" -o "a.o"')
+      expect(Dir.empty?( @tmpdir )).to be true
+    end
+  end
 end